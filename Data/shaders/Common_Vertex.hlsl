@@ -23,6 +23,36 @@ struct Vertex_PosUvNorTan
     float3 tangent		: TANGENT0;
 };
 
+// Per instance data of instanced draws, each matrix arrives as the four 16 byte columns it has in a constant buffer
+struct Instance_Transform
+{
+	float4 wvp_0 : INSTANCE_WVP0;
+	float4 wvp_1 : INSTANCE_WVP1;
+	float4 wvp_2 : INSTANCE_WVP2;
+	float4 wvp_3 : INSTANCE_WVP3;
+};
+
+struct Instance_TransformHistory
+{
+	float4 world_0 			: INSTANCE_WORLD0;
+	float4 world_1 			: INSTANCE_WORLD1;
+	float4 world_2 			: INSTANCE_WORLD2;
+	float4 world_3 			: INSTANCE_WORLD3;
+	float4 wvp_0 			: INSTANCE_WVP0;
+	float4 wvp_1 			: INSTANCE_WVP1;
+	float4 wvp_2 			: INSTANCE_WVP2;
+	float4 wvp_3 			: INSTANCE_WVP3;
+	float4 wvp_previous_0 	: INSTANCE_WVP_PREVIOUS0;
+	float4 wvp_previous_1 	: INSTANCE_WVP_PREVIOUS1;
+	float4 wvp_previous_2 	: INSTANCE_WVP_PREVIOUS2;
+	float4 wvp_previous_3 	: INSTANCE_WVP_PREVIOUS3;
+};
+
+matrix instance_matrix(float4 column_0, float4 column_1, float4 column_2, float4 column_3)
+{
+	return transpose(matrix(column_0, column_1, column_2, column_3));
+}
+
 struct Pixel_Pos
 {
     float4 position : SV_POSITION;
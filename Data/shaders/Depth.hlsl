@@ -2,14 +2,11 @@
 #include "Common.hlsl"
 //====================
 
-cbuffer ObjectBuffer : register(b1)
-{		
-	matrix mvp;
-};
-Pixel_Pos mainVS(Vertex_Pos input)
+Pixel_Pos mainVS(Vertex_Pos input, Instance_Transform instance)
 {
 	Pixel_Pos output;
 
+	matrix mvp			= instance_matrix(instance.wvp_0, instance.wvp_1, instance.wvp_2, instance.wvp_3);
 	input.position.w 	= 1.0f;	
     output.position 	= mul(input.position, mvp);
 	
@@ -30,13 +30,6 @@ cbuffer MaterialBuffer : register(b1)
 	float3 padding2;
 };
 
-cbuffer ObjectBuffer : register(b2)
-{		
-	matrix mModel;
-	matrix mMVP_current;
-	matrix mMVP_previous;
-};
-
 struct PixelInputType
 {
     float4 positionCS 			: SV_POSITION;
@@ -57,10 +50,14 @@ struct PixelOutputType
 	float2 velocity	: SV_Target3;
 };
 
-PixelInputType mainVS(Vertex_PosUvNorTan input)
+PixelInputType mainVS(Vertex_PosUvNorTan input, Instance_TransformHistory instance)
 {
     PixelInputType output;
     
+	matrix mModel				= instance_matrix(instance.world_0, instance.world_1, instance.world_2, instance.world_3);
+	matrix mMVP_current			= instance_matrix(instance.wvp_0, instance.wvp_1, instance.wvp_2, instance.wvp_3);
+	matrix mMVP_previous		= instance_matrix(instance.wvp_previous_0, instance.wvp_previous_1, instance.wvp_previous_2, instance.wvp_previous_3);
+	
     input.position.w 			= 1.0f;	
 	output.positionWS 			= mul(input.position, mModel);
     output.positionVS   		= mul(output.positionWS, g_view);
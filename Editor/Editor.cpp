@@ -63,8 +63,8 @@ Editor::Editor(void* window_handle, void* window_instance, float window_width, f
 	
 	// Acquire useful engine subsystems
 	m_context	= m_engine->GetContext();
-	m_renderer	= m_context->GetSubsystem<Renderer>().get();
-	m_timer		= m_context->GetSubsystem<Timer>().get();
+	m_renderer	= m_context->GetSubsystem<Renderer>();
+	m_timer		= m_context->GetSubsystem<Timer>();
 	m_rhiDevice = m_renderer->GetRhiDevice();
 
 	if (!m_renderer->IsInitialized())
@@ -73,7 +73,7 @@ namespace ImGui::RHI
 	inline bool Initialize(Context* context, const float width, const float height)
 	{
 		g_context		= context;
-		g_renderer		= context->GetSubsystem<Renderer>().get();
+		g_renderer		= context->GetSubsystem<Renderer>();
 		g_cmd_list		= g_renderer->GetCmdList().get();
 		g_rhi_device	= g_renderer->GetRhiDevice();
 		
@@ -37,7 +37,7 @@ Widget_Profiler::Widget_Profiler(Context* context) : Widget(context)
 	m_windowFlags |= ImGuiWindowFlags_AlwaysAutoResize;
 	m_title							= "Profiler";
 	m_isVisible						= false;
-	m_profiler						= m_context->GetSubsystem<Profiler>().get();
+	m_profiler						= m_context->GetSubsystem<Profiler>();
 	m_xMin							= 1000;
 	m_yMin							= 715;
 	m_xMax							= FLT_MAX;
@@ -74,8 +74,8 @@ Widget_Toolbar::Widget_Toolbar(Context* context) : Widget(context)
 		ImGuiWindowFlags_NoTitleBar;
 
 	Engine::EngineMode_Disable(Engine_Game);
-	m_renderer							= context->GetSubsystem<Renderer>().get();
-	_Widget_Toolbar::g_resourceCache	= context->GetSubsystem<ResourceCache>().get();
+	m_renderer							= context->GetSubsystem<Renderer>();
+	_Widget_Toolbar::g_resourceCache	= context->GetSubsystem<ResourceCache>();
 
 	m_profiler		= make_unique<Widget_Profiler>(context);
 	m_resourceCache = make_unique<Widget_ResourceCache>(context);
@@ -41,7 +41,7 @@ namespace Spartan
 {
 	Audio::Audio(Context* context) : ISubsystem(context)
 	{
-		m_profiler = m_context->GetSubsystem<Profiler>().get();
+		m_profiler = m_context->GetSubsystem<Profiler>();
 
 		// Create FMOD instance
 		m_result_fmod = System_Create(&m_system_fmod);
@@ -102,13 +102,13 @@ namespace Spartan
 		Settings::Get().m_versionFMOD = major + "." + minor + "." + rev;
 
 		// Subscribe to events
-		SUBSCRIBE_TO_EVENT(Event_World_Unload, [this](Variant) { m_listener = nullptr; });
+		m_subscription_world_unload = SUBSCRIBE_TO_EVENT(Event_World_Unload, [this](Variant) { m_listener = nullptr; });
 	}
 
 	Audio::~Audio()
 	{
 		// Unsubscribe from events
-		UNSUBSCRIBE_FROM_EVENT(Event_World_Unload, [this](Variant) { m_listener = nullptr; });
+		UNSUBSCRIBE_FROM_EVENT(Event_World_Unload, m_subscription_world_unload);
 
 		if (!m_system_fmod)
 			return;
@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ==================
 #include "../Core/ISubsystem.h"
+#include "../Core/EventSystem.h"
 #include <cstdint>
 //=============================
 
@@ -61,5 +62,6 @@ namespace Spartan
 		Transform* m_listener		= nullptr;
 		Profiler* m_profiler		= nullptr;
 		FMOD::System* m_system_fmod = nullptr;
+		Subscription m_subscription_world_unload = 0;
 	};
 }
\ No newline at end of file
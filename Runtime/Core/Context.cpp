@@ -0,0 +1,137 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ====================================
+#include "Context.h"
+#include "../Threading/Threading.h"
+#include "../World/Components/ComponentPool.h"
+//===============================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	Context::Context()
+	{
+		// Shared, components keep their pool alive until they are destroyed
+		m_component_pools = make_shared<ComponentPools>();
+	}
+
+	bool Context::Initialize()
+	{
+		m_threading = GetSubsystem<Threading>();
+
+		auto result = true;
+		for (const auto& subsystem : m_subsystems)
+		{
+			if (!subsystem.ptr->Initialize())
+			{
+				LOGF_ERROR("Failed to initialize %s", typeid(*subsystem.ptr).name());
+				result = false;
+			}
+		}
+
+		return result;
+	}
+
+	void Context::Tick()
+	{
+		// Without worker threads, tick in registration order (which always satisfies the dependencies)
+		if (!m_threading || m_threading->GetThreadCount() == 0)
+		{
+			for (const auto& subsystem : m_subsystems)
+			{
+				subsystem.ptr->Tick();
+			}
+			return;
+		}
+
+		// The calling thread drives the frame graph. A subsystem is only dispatched once all of its
+		// dependencies are done, so workers never block inside a tick waiting on another tick.
+		const auto subsystem_count = static_cast<uint32_t>(m_subsystems.size());
+		vector<TaskCounter> counters(subsystem_count);
+		vector<bool> dispatched(subsystem_count, false);
+		uint32_t dispatched_count = 0;
+
+		auto is_ready = [this, &counters, &dispatched](const uint32_t index)
+		{
+			for (const auto dependency : m_subsystems[index].dependencies)
+			{
+				if (!dispatched[dependency] || !counters[dependency].IsDone())
+					return false;
+			}
+			return true;
+		};
+
+		while (dispatched_count < subsystem_count)
+		{
+			// Hand every ready subsystem which can tick anywhere to the workers
+			for (uint32_t i = 0; i < subsystem_count; i++)
+			{
+				if (dispatched[i] || m_subsystems[i].affinity != Tick_Affinity_Any || !is_ready(i))
+					continue;
+
+				ISubsystem* subsystem = m_subsystems[i].ptr.get();
+				m_threading->AddTask([subsystem]() { subsystem->Tick(); }, &counters[i]);
+				dispatched[i] = true;
+				dispatched_count++;
+			}
+
+			// Tick the first ready main thread subsystem, in registration order
+			auto ticked = false;
+			for (uint32_t i = 0; i < subsystem_count; i++)
+			{
+				if (dispatched[i] || m_subsystems[i].affinity != Tick_Affinity_Main)
+					continue;
+
+				if (is_ready(i))
+				{
+					m_subsystems[i].ptr->Tick();
+					dispatched[i] = true;
+					dispatched_count++;
+					ticked = true;
+				}
+				break;
+			}
+
+			// Nothing could progress on this thread, help the workers until a dispatched tick completes
+			if (!ticked)
+			{
+				for (uint32_t i = 0; i < subsystem_count; i++)
+				{
+					if (dispatched[i] && !counters[i].IsDone())
+					{
+						m_threading->Wait(counters[i]);
+						break;
+					}
+				}
+			}
+		}
+
+		// Everything must have ticked before the frame ends
+		for (const auto& counter : counters)
+		{
+			m_threading->Wait(counter);
+		}
+	}
+}
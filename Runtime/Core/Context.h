@@ -22,7 +22,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES ==============
+#include <array>
 #include <vector>
+#include <memory>
+#include <typeinfo>
 #include "EngineDefs.h"
 #include "ISubsystem.h"
 #include "../Logging/Log.h"
@@ -30,62 +33,105 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Spartan
 {
-	#define VALIDATE_SUBSYSTEM_TYPE(T) static_assert(std::is_base_of<ISubsystem, T>::value, "Provided type does not implement ISubystem")
+	class Threading;
+	class ComponentPools;
+
+	#define VALIDATE_SUBSYSTEM_TYPE(T)			static_assert(std::is_base_of<ISubsystem, T>::value, "Provided type does not implement ISubystem")
+	#define VALIDATE_SUBSYSTEM_REGISTERED(T)	static_assert(ISubsystem::TypeToEnum<T>() != Subsystem_Unknown, "Provided type is not registered in ISubsystem.h")
+
+	// Which threads a subsystem's Tick() can run on
+	enum Tick_Affinity
+	{
+		Tick_Affinity_Main,	// Always ticks on the thread which calls Context::Tick()
+		Tick_Affinity_Any	// Can tick on a worker thread, concurrently with anything it doesn't depend on
+	};
 
 	class SPARTAN_CLASS Context
 	{
 	public:
-		Context() = default;
-		~Context() { m_subsystems.clear(); }
-
-		// Register a subsystem
-		template <class T>
-		void RegisterSubsystem()
-		{
-			VALIDATE_SUBSYSTEM_TYPE(T);
-			m_subsystems.emplace_back(std::make_shared<T>(this));
-		}
-
-		// Initialize subsystems
-		bool Initialize()
+		Context();
+		~Context()
 		{
-			auto result = true;
-			for (const auto& subsystem : m_subsystems)
+			// Destroy in reverse registration order, so that subsystems outlive the ones which depend on them.
+			// A slot is only cleared once its subsystem is gone, the others can still be reached while it's destroyed.
+			while (!m_subsystems.empty())
 			{
-				if (!subsystem->Initialize())
+				auto subsystem = m_subsystems.back().ptr;
+				m_subsystems.pop_back();
+				for (auto& slot : m_subsystem_slots)
 				{
-					LOGF_ERROR("Failed to initialize %s", typeid(*subsystem).name());
-					result = false;
+					if (slot == subsystem.get())
+					{
+						slot = nullptr;
+					}
 				}
+				subsystem.reset();
 			}
-
-			return result;
 		}
 
-		// Tick subsystems
-		void Tick()
+		// Register a subsystem, it will tick only after the given (already registered) subsystems have ticked
+		template <class T, class... Dependencies>
+		void RegisterSubsystem(const Tick_Affinity affinity = Tick_Affinity_Main)
 		{
-			for (const auto& subsystem : m_subsystems)
-			{
-				subsystem->Tick();
-			}
+			VALIDATE_SUBSYSTEM_TYPE(T);
+			VALIDATE_SUBSYSTEM_REGISTERED(T);
+
+			_Subsystem subsystem;
+			subsystem.ptr		= std::make_shared<T>(this);
+			subsystem.affinity	= affinity;
+			(AddTickDependency<Dependencies>(subsystem), ...);
+
+			m_subsystem_slots[ISubsystem::TypeToEnum<T>()] = subsystem.ptr.get();
+			m_subsystems.emplace_back(std::move(subsystem));
 		}
 
-		// Get a subsystem
+		// Initialize subsystems
+		bool Initialize();
+
+		// Tick subsystems, respecting their declared dependencies
+		void Tick();
+
+		// Get a subsystem, the context owns it for its entire lifetime
 		template <class T> 
-		std::shared_ptr<T> GetSubsystem()
+		T* GetSubsystem() const
+		{
+			VALIDATE_SUBSYSTEM_TYPE(T);
+			VALIDATE_SUBSYSTEM_REGISTERED(T);
+			return static_cast<T*>(m_subsystem_slots[ISubsystem::TypeToEnum<T>()]);
+		}
+
+		// Component storage for the entities of this context
+		ComponentPools* GetComponentPools() const { return m_component_pools.get(); }
+
+	private:
+		struct _Subsystem
+		{
+			std::shared_ptr<ISubsystem> ptr;
+			Tick_Affinity affinity = Tick_Affinity_Main;
+			std::vector<uint32_t> dependencies;
+		};
+
+		template <class T>
+		void AddTickDependency(_Subsystem& subsystem)
 		{
 			VALIDATE_SUBSYSTEM_TYPE(T);
-			for (const auto& subsystem : m_subsystems)
+			VALIDATE_SUBSYSTEM_REGISTERED(T);
+			const ISubsystem* dependency = m_subsystem_slots[ISubsystem::TypeToEnum<T>()];
+			for (uint32_t i = 0; i < static_cast<uint32_t>(m_subsystems.size()); i++)
 			{
-				if (typeid(T) == typeid(*subsystem))
-					return std::static_pointer_cast<T>(subsystem);
+				if (m_subsystems[i].ptr.get() == dependency)
+				{
+					subsystem.dependencies.emplace_back(i);
+					return;
+				}
 			}
 
-			return nullptr;
+			LOGF_ERROR("%s must be registered before the subsystems which depend on it", typeid(T).name());
 		}
 
-	private:
-		std::vector<std::shared_ptr<ISubsystem>> m_subsystems;
+		std::vector<_Subsystem> m_subsystems; // in registration order
+		std::array<ISubsystem*, Subsystem_Unknown> m_subsystem_slots = {};
+		Threading* m_threading = nullptr;
+		std::shared_ptr<ComponentPools> m_component_pools;
 	};
-}
\ No newline at end of file
+}
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Timer.h"
 #include "../Audio/Audio.h"
 #include "../Input/Input.h"
+#include "../IO/Streaming.h"
 #include "../Physics/Physics.h"
 #include "../Profiling/Profiler.h"
 #include "../Rendering/Renderer.h"
@@ -54,17 +55,18 @@ namespace Spartan
 		FileSystem::Initialize();
 		Settings::Get().Initialize();
 
-		// Register subsystems
+		// Register subsystems (along with the subsystems they must tick after)
 		m_context->RegisterSubsystem<Timer>();
-		m_context->RegisterSubsystem<Profiler>();
-		m_context->RegisterSubsystem<ResourceCache>();
-		m_context->RegisterSubsystem<Renderer>();	
-		m_context->RegisterSubsystem<Threading>();	
-		m_context->RegisterSubsystem<Input>();
-		m_context->RegisterSubsystem<Audio>();		
-		m_context->RegisterSubsystem<Scripting>();
-		m_context->RegisterSubsystem<Physics>();	
-		m_context->RegisterSubsystem<World>();		
+		m_context->RegisterSubsystem<Profiler, Timer>();
+		m_context->RegisterSubsystem<ResourceCache, Timer>();
+		m_context->RegisterSubsystem<Renderer, Timer>();
+		m_context->RegisterSubsystem<Threading, Timer>();
+		m_context->RegisterSubsystem<Streaming, Timer>();
+		m_context->RegisterSubsystem<Input, Timer>();
+		m_context->RegisterSubsystem<Audio, Timer>();										// reads transforms, so it ticks on the main thread, serialized with the renderer and scripts
+		m_context->RegisterSubsystem<Scripting, Timer>();
+		m_context->RegisterSubsystem<Physics, Timer, ResourceCache, Renderer, Audio, Scripting>(Tick_Affinity_Any);	// writes transforms, so it ticks after everything else which touches them (finalized models, rendering, audio, scripts)
+		m_context->RegisterSubsystem<World, Input, Physics>();								// ticks entities and scripts, which read input and simulated transforms
 
 		// Initialize above subsystems
 		m_context->Initialize();
@@ -77,6 +79,9 @@ namespace Spartan
 
 	void Engine::Tick() const
 	{
+		// Dispatch events which were queued (possibly from other threads) during the previous frame
+		EventSystem::Get().ProcessQueue();
+
 		FIRE_EVENT(Event_Frame_Start);
 
 		if (EngineMode_IsSet(Engine_Tick))
@@ -27,6 +27,7 @@ constexpr auto engine_version = "v0.31 WIP";
 // APIs
 #define API_GRAPHICS_D3D11
 //#define API_GRAPHICS_VULKAN
+//#define API_GRAPHICS_NULL // headless, nothing is rendered
 #define API_INPUT_WINDOWS
 
 // Class
@@ -22,22 +22,29 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES ===============
-#include <map>
+#include <array>
+#include <atomic>
+#include <mutex>
 #include <vector>
 #include <functional>
 #include "../Core/Variant.h"
+#include "../Logging/Log.h"
 //==========================
 
 /*
 HOW TO USE
-=================================================================================
-To subscribe a function to an event		-> SUBSCRIBE_TO_EVENT(EVENT_ID, Handler);
-To unsubscribe a function from an event	-> SUBSCRIBE_TO_EVENT(EVENT_ID, Handler);
+=====================================================================================================
+To subscribe a function to an event		-> auto subscription = SUBSCRIBE_TO_EVENT(EVENT_ID, Handler);
+To unsubscribe a function from an event	-> UNSUBSCRIBE_FROM_EVENT(EVENT_ID, subscription);
 To fire an event						-> FIRE_EVENT(EVENT_ID);
 To fire an event with data				-> FIRE_EVENT_DATA(EVENT_ID, Variant);
+To queue an event from any thread		-> FIRE_EVENT_QUEUED(EVENT_ID, Variant);
 
-Note: Currently, this is a blocking event system
-=================================================================================
+Note: FIRE_EVENT is blocking, the subscribers run on the calling thread.
+FIRE_EVENT_QUEUED is thread-safe and the subscribers run on the main thread, on the next frame start.
+Data is passed by reference to immediate subscribers (use a pointer type to avoid copying large data),
+queued events store a copy of their data until they are dispatched.
+=====================================================================================================
 */
 
 enum Event_Type
@@ -52,24 +59,29 @@ enum Event_Type
 	Event_World_Resolve,		// The world should resolve
 	Event_World_Submit,			// The world is submitting entities to the renderer
 	Event_World_Stop,			// The world should stop ticking
-	Event_World_Start			// The world should start ticking
+	Event_World_Start,			// The world should start ticking
+	Event_Count					// Not an event, the number of event types
 };
 
-//= MACROS ====================================================================================================
+//= MACROS ===================================================================================================================
 #define EVENT_HANDLER_STATIC(function)				[](const Spartan::Variant& var)		{ function(); }
 #define EVENT_HANDLER(function)						[this](const Spartan::Variant& var)	{ function(); }
 #define EVENT_HANDLER_VARIANT(function)				[this](const Spartan::Variant& var)	{ function(var); }
 #define EVENT_HANDLER_VARIANT_STATIC(function)		[](const Spartan::Variant& var)		{ function(var); }
-#define SUBSCRIBE_TO_EVENT(eventID, function)		Spartan::EventSystem::Get().Subscribe(eventID, function);
-#define UNSUBSCRIBE_FROM_EVENT(eventID, function)	Spartan::EventSystem::Get().Unsubscribe(eventID, function);
+#define SUBSCRIBE_TO_EVENT(eventID, function)		Spartan::EventSystem::Get().Subscribe(eventID, function)
+#define UNSUBSCRIBE_FROM_EVENT(eventID, subscription)	Spartan::EventSystem::Get().Unsubscribe(eventID, subscription)
 #define FIRE_EVENT(eventID)							Spartan::EventSystem::Get().Fire(eventID)
 #define FIRE_EVENT_DATA(eventID, data)				Spartan::EventSystem::Get().Fire(eventID, data)
-//=============================================================================================================
+#define FIRE_EVENT_QUEUED(eventID, data)			Spartan::EventSystem::Get().FireQueued(eventID, data)
+//============================================================================================================================
 
 namespace Spartan
 {
 	using subscriber = std::function<void(const Variant&)>;
 
+	// Identifies a subscription so that it can be removed later, 0 is never a valid subscription
+	typedef uint32_t Subscription;
+
 	class SPARTAN_CLASS EventSystem
 	{
 	public:
@@ -79,22 +91,58 @@ namespace Spartan
 			return instance;
 		}
 
-		void Subscribe(const Event_Type event_id, subscriber&& function)
+		Subscription Subscribe(const Event_Type event_id, subscriber&& function)
 		{
-			m_subscribers[event_id].push_back(std::forward<subscriber>(function));
+			std::lock_guard<std::mutex> lock(m_subscribe_mutex);
+
+			// Reuse a slot freed by Unsubscribe() before growing, but only while the event isn't being fired,
+			// as a Fire() which started before the slot was freed could still be calling the previous function
+			auto& event	= m_events[event_id];
+			uint32_t slot	= 0;
+			bool append	= false;
+			if (event.free_count > 0 && event.firing.load() == 0)
+			{
+				slot = event.free_slots[--event.free_count];
+			}
+			else
+			{
+				slot	= event.count.load(std::memory_order_relaxed);
+				append	= true;
+				if (slot >= max_subscribers)
+				{
+					LOGF_ERROR("Event %d has reached the maximum of %d subscribers", event_id, max_subscribers);
+					return 0;
+				}
+			}
+
+			// A slot is published by storing its subscription last, so that Fire() can walk them without taking a lock
+			const Subscription subscription = m_subscription_next++;
+			event.subscribers[slot].function = std::forward<subscriber>(function);
+			event.subscribers[slot].subscription.store(subscription);
+			if (append)
+			{
+				event.count.store(slot + 1, std::memory_order_release);
+			}
+
+			return subscription;
 		}
 
-		void Unsubscribe(const Event_Type event_id, subscriber&& function)
+		// Note: a subscriber which is executing on another thread may still complete after this returns
+		void Unsubscribe(const Event_Type event_id, const Subscription subscription)
 		{
-			const size_t function_adress	= *reinterpret_cast<long*>(reinterpret_cast<char*>(&function));
-			auto& subscribers				= m_subscribers[event_id];
+			if (subscription == 0)
+				return;
+
+			std::lock_guard<std::mutex> lock(m_subscribe_mutex);
 
-			for (auto it = subscribers.begin(); it != subscribers.end();)
+			auto& event		= m_events[event_id];
+			const auto count	= event.count.load(std::memory_order_relaxed);
+			for (uint32_t i = 0; i < count; i++)
 			{
-				const size_t subscriber_adress = *reinterpret_cast<long*>(reinterpret_cast<char*>(&(*it)));
-				if (subscriber_adress == function_adress)
+				if (event.subscribers[i].subscription.load(std::memory_order_relaxed) == subscription)
 				{
-					it = subscribers.erase(it);
+					event.subscribers[i].subscription.store(0);
+					event.free_slots[event.free_count++] = i;
 					return;
 				}
 			}
@@ -102,21 +150,95 @@ namespace Spartan
 
 		void Fire(const Event_Type event_id, const Variant& data = 0)
 		{
-			if (m_subscribers.find(event_id) == m_subscribers.end())
-				return;
+			// The slot accesses are sequentially consistent with the firing count, so that Subscribe() either sees
+			// this call in flight, or this call sees the slot as freed (or as reused, once it's fully written)
+			auto& event			= m_events[event_id];
+			event.firing++;
+			const auto count	= event.count.load(std::memory_order_acquire);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				if (event.subscribers[i].subscription.load() != 0)
+				{
+					event.subscribers[i].function(data);
+				}
+			}
+			event.firing--;
+		}
 
-			for (const auto& subscriber : m_subscribers[event_id])
+		// Thread-safe, the event is dispatched by the next ProcessQueue()
+		void FireQueued(const Event_Type event_id, const Variant& data = 0)
+		{
+			std::lock_guard<std::mutex> lock(m_queue_mutex);
+			m_queue.emplace_back(event_id, data);
+		}
+
+		// Dispatches all queued events on the calling thread, called at frame boundaries
+		void ProcessQueue()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_queue_mutex);
+				if (m_queue.empty())
+					return;
+
+				// Swap so that subscribers can queue more events, both vectors keep their capacity
+				m_queue.swap(m_queue_processing);
+			}
+
+			for (const auto& event : m_queue_processing)
 			{
-				subscriber(data);
+				Fire(event.first, event.second);
 			}
+			m_queue_processing.clear();
 		}
 
 		void Clear() 
 		{
-			m_subscribers.clear(); 
+			std::lock_guard<std::mutex> lock(m_subscribe_mutex);
+			for (auto& event : m_events)
+			{
+				const auto count = event.count.load(std::memory_order_relaxed);
+				event.count.store(0, std::memory_order_release);
+				event.free_count = 0;
+				for (uint32_t i = 0; i < count; i++)
+				{
+					event.subscribers[i].subscription.store(0, std::memory_order_relaxed);
+					event.subscribers[i].function = nullptr;
+				}
+			}
+
+			std::lock_guard<std::mutex> lock_queue(m_queue_mutex);
+			m_queue.clear();
 		}
 
 	private:
-		std::map<Event_Type, std::vector<subscriber>> m_subscribers;
+		static const uint32_t max_subscribers = 32;
+
+		struct _Subscriber
+		{
+			std::atomic<Subscription> subscription = 0;
+			subscriber function;
+		};
+
+		struct _Event
+		{
+			std::array<_Subscriber, max_subscribers> subscribers;
+			std::atomic<uint32_t> count = 0;
+
+			// Slots released by Unsubscribe(), guarded by m_subscribe_mutex
+			std::array<uint32_t, max_subscribers> free_slots;
+			uint32_t free_count = 0;
+			// Number of Fire() calls in flight, freed slots are only reused when there are none
+			std::atomic<uint32_t> firing = 0;
+		};
+
+		// Indexed by Event_Type
+		std::array<_Event, Event_Count> m_events;
+		std::mutex m_subscribe_mutex;
+		Subscription m_subscription_next = 1;
+
+		// Queued events
+		std::vector<std::pair<Event_Type, Variant>> m_queue;
+		std::vector<std::pair<Event_Type, Variant>> m_queue_processing;
+		std::mutex m_queue_mutex;
 	};
-}
\ No newline at end of file
+}
@@ -28,6 +28,34 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace Spartan
 {
 	class Context;
+	class Timer;
+	class Profiler;
+	class ResourceCache;
+	class Renderer;
+	class Threading;
+	class Streaming;
+	class Input;
+	class Audio;
+	class Scripting;
+	class Physics;
+	class World;
+
+	// Each subsystem gets a fixed slot in the context, so that lookups are a single index
+	enum Subsystem_Type
+	{
+		Subsystem_Timer,
+		Subsystem_Profiler,
+		Subsystem_ResourceCache,
+		Subsystem_Renderer,
+		Subsystem_Threading,
+		Subsystem_Streaming,
+		Subsystem_Input,
+		Subsystem_Audio,
+		Subsystem_Scripting,
+		Subsystem_Physics,
+		Subsystem_World,
+		Subsystem_Unknown
+	};
 
 	class SPARTAN_CLASS ISubsystem
 	{		
@@ -40,8 +68,29 @@ namespace Spartan
 		virtual bool Initialize() { return true; }
 		virtual void Tick() {}
 
+		//= TYPE ============================================================
+		template <typename T>
+		static constexpr Subsystem_Type TypeToEnum() { return Subsystem_Unknown; }
+		//===================================================================
+
 	protected:
 		Context* m_context;
 		static float m_delta_time_sec;
 	};
+
+	// Defined here (instead of a translation unit) so that lookups resolve at compile time
+	#define REGISTER_SUBSYSTEM(T, enumT) template<> constexpr Subsystem_Type ISubsystem::TypeToEnum<T>() { return enumT; }
+
+	// To add a new subsystem to the engine, simply register it here
+	REGISTER_SUBSYSTEM(Timer,			Subsystem_Timer)
+	REGISTER_SUBSYSTEM(Profiler,		Subsystem_Profiler)
+	REGISTER_SUBSYSTEM(ResourceCache,	Subsystem_ResourceCache)
+	REGISTER_SUBSYSTEM(Renderer,		Subsystem_Renderer)
+	REGISTER_SUBSYSTEM(Threading,		Subsystem_Threading)
+	REGISTER_SUBSYSTEM(Streaming,		Subsystem_Streaming)
+	REGISTER_SUBSYSTEM(Input,			Subsystem_Input)
+	REGISTER_SUBSYSTEM(Audio,			Subsystem_Audio)
+	REGISTER_SUBSYSTEM(Scripting,		Subsystem_Scripting)
+	REGISTER_SUBSYSTEM(Physics,			Subsystem_Physics)
+	REGISTER_SUBSYSTEM(World,			Subsystem_World)
 }
\ No newline at end of file
@@ -35,6 +35,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace Spartan
 {
 	class Entity;
+	struct WorldChanges;
 }
 //========================
 
@@ -52,6 +53,8 @@ namespace Spartan
 	std::weak_ptr<Spartan::Entity>,					\
 	std::vector<std::weak_ptr<Spartan::Entity>>,	\
 	std::vector<std::shared_ptr<Spartan::Entity>>,	\
+	const std::vector<std::shared_ptr<Spartan::Entity>>*,	\
+	const Spartan::WorldChanges*,					\
 	Spartan::Math::Vector2,							\
 	Spartan::Math::Vector3,							\
 	Spartan::Math::Vector4,							\
@@ -0,0 +1,537 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ========================
+#include "Archive.h"
+#include <mutex>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include "../Logging/Log.h"
+#include "../FileSystem/FileSystem.h"
+//===================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	namespace _Archive
+	{
+		const char magic[4]				= { 'S', 'P', 'A', 'K' };
+		const uint32_t version			= 1;
+		const uint32_t alignment		= 64;
+
+		struct Header
+		{
+			char magic[4];
+			uint32_t version;
+			uint32_t entry_count;
+			uint32_t alignment;
+			uint64_t toc_offset;
+			uint64_t strings_offset;
+			uint64_t strings_size;
+			uint64_t padding;
+		};
+
+		struct TocEntry
+		{
+			uint64_t path_hash;
+			uint64_t offset;
+			uint64_t size;
+			uint64_t size_uncompressed;
+			uint32_t path_offset;
+			uint32_t path_length;
+			uint32_t compression;
+			uint32_t padding;
+		};
+
+		static_assert(sizeof(Header) == 48 && sizeof(TocEntry) == 48, "The archive layout must not depend on the compiler");
+
+		// Later mounts come first, so they are searched first
+		static vector<shared_ptr<Archive>> mounted;
+		static mutex mount_mutex;
+		static atomic<bool> any_mounted = false; // so that lookups are free when nothing is mounted
+
+		// The engine refers to the same file with absolute and relative paths and with any kind or amount of slashes
+		static string normalize(const string& path)
+		{
+			string result;
+			result.reserve(path.size());
+			for (auto c : path)
+			{
+				c = c == '\\' ? '/' : c;
+				if (c == '/' && !result.empty() && result.back() == '/')
+					continue;
+
+				result += c;
+			}
+
+			static const auto working_directory = FileSystem::GetWorkingDirectory();
+			if (result.compare(0, working_directory.size(), working_directory) == 0)
+			{
+				result.erase(0, working_directory.size());
+			}
+
+			while (result.compare(0, 2, "./") == 0)
+			{
+				result.erase(0, 2);
+			}
+
+			return result;
+		}
+
+		// FNV-1a
+		static uint64_t hash(const string& path)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (const auto c : path)
+			{
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		static void write_length(vector<std::byte>& output, uint64_t length)
+		{
+			while (length >= 255)
+			{
+				output.emplace_back(std::byte{ 255 });
+				length -= 255;
+			}
+			output.emplace_back(static_cast<std::byte>(length));
+		}
+
+		// Greedy LZ4 block compression, a single hash table probe per position. Favours speed over ratio,
+		// the point is to read less from disk while decompression stays close to memcpy speed.
+		static vector<std::byte> compress(const uint8_t* input, const uint64_t size)
+		{
+			const uint32_t hash_bits		= 16;
+			const uint64_t match_min		= 4;
+			const uint64_t literals_last	= 5;	// the block has to end with at least this many literals
+			const uint64_t match_start_last	= 12;	// and no match can start this close to its end
+			const uint64_t distance_max		= 65535;
+
+			vector<std::byte> output;
+			output.reserve(size + size / 255 + 16);
+			vector<uint32_t> table(size_t(1) << hash_bits, 0);
+
+			uint64_t anchor = 0;
+			uint64_t position = 0;
+			const auto match_limit = size > match_start_last ? size - match_start_last : 0;
+			while (position < match_limit)
+			{
+				uint32_t sequence;
+				memcpy(&sequence, input + position, sizeof(sequence));
+				const auto slot			= (sequence * 2654435761u) >> (32 - hash_bits);
+				const uint64_t candidate	= table[slot];
+				table[slot]				= static_cast<uint32_t>(position);
+
+				if (candidate >= position || position - candidate > distance_max || memcmp(input + candidate, input + position, match_min) != 0)
+				{
+					position++;
+					continue;
+				}
+
+				auto match_length = match_min;
+				while (position + match_length < size - literals_last && input[candidate + match_length] == input[position + match_length])
+				{
+					match_length++;
+				}
+
+				// Token, literal length, literals, offset, match length
+				const auto literal_length	= position - anchor;
+				const auto match_code		= match_length - match_min;
+				output.emplace_back(static_cast<std::byte>((min<uint64_t>(literal_length, 15) << 4) | min<uint64_t>(match_code, 15)));
+				if (literal_length >= 15)
+				{
+					write_length(output, literal_length - 15);
+				}
+				output.insert(output.end(), reinterpret_cast<const std::byte*>(input + anchor), reinterpret_cast<const std::byte*>(input + position));
+				const auto distance = position - candidate;
+				output.emplace_back(static_cast<std::byte>(distance & 0xFF));
+				output.emplace_back(static_cast<std::byte>(distance >> 8));
+				if (match_code >= 15)
+				{
+					write_length(output, match_code - 15);
+				}
+
+				position	+= match_length;
+				anchor		= position;
+			}
+
+			// The remaining literals, without a match
+			const auto literal_length = size - anchor;
+			output.emplace_back(static_cast<std::byte>(min<uint64_t>(literal_length, 15) << 4));
+			if (literal_length >= 15)
+			{
+				write_length(output, literal_length - 15);
+			}
+			output.insert(output.end(), reinterpret_cast<const std::byte*>(input + anchor), reinterpret_cast<const std::byte*>(input + size));
+
+			return output;
+		}
+
+		// Every length and offset is checked, a corrupt archive fails to decompress instead of writing out of bounds
+		static bool decompress(const uint8_t* input, const uint64_t input_size, uint8_t* output, const uint64_t output_size)
+		{
+			const auto input_end	= input + input_size;
+			const auto output_start	= output;
+			const auto output_end	= output + output_size;
+
+			auto read_length = [&input, input_end](uint64_t& length)
+			{
+				uint8_t value;
+				do
+				{
+					if (input >= input_end)
+						return false;
+
+					value	= *input++;
+					length	+= value;
+				} while (value == 255);
+
+				return true;
+			};
+
+			while (input < input_end)
+			{
+				const auto token = *input++;
+
+				uint64_t literal_length = token >> 4;
+				if (literal_length == 15 && !read_length(literal_length))
+					return false;
+
+				if (literal_length > static_cast<uint64_t>(input_end - input) || literal_length > static_cast<uint64_t>(output_end - output))
+					return false;
+
+				memcpy(output, input, literal_length);
+				input	+= literal_length;
+				output	+= literal_length;
+
+				// The last sequence has no match
+				if (input == input_end)
+					break;
+
+				if (input_end - input < 2)
+					return false;
+
+				const uint64_t distance = input[0] | (input[1] << 8);
+				input += 2;
+				if (distance == 0 || distance > static_cast<uint64_t>(output - output_start))
+					return false;
+
+				uint64_t match_length = token & 15;
+				if (match_length == 15 && !read_length(match_length))
+					return false;
+
+				match_length += 4;
+				if (match_length > static_cast<uint64_t>(output_end - output))
+					return false;
+
+				// Byte by byte, the match can overlap what it writes
+				const auto match = output - distance;
+				for (uint64_t i = 0; i < match_length; i++)
+				{
+					output[i] = match[i];
+				}
+				output += match_length;
+			}
+
+			return output == output_end;
+		}
+
+		static bool read_file(const string& file_path, vector<std::byte>* data)
+		{
+			ifstream file(file_path, ios::binary | ios::ate);
+			if (!file.is_open())
+				return false;
+
+			data->resize(static_cast<size_t>(file.tellg()));
+			file.seekg(0);
+			file.read(reinterpret_cast<char*>(data->data()), data->size());
+			return static_cast<size_t>(file.gcount()) == data->size();
+		}
+	}
+
+	bool Archive::Create(const string& archive_path, const vector<string>& file_paths, const bool compress /*= true*/)
+	{
+		// Paths, skipping duplicates
+		vector<string> paths;
+		vector<string> paths_source;
+		vector<_Archive::TocEntry> toc;
+		string strings;
+		unordered_map<uint64_t, uint32_t> lookup;
+		for (const auto& file_path : file_paths)
+		{
+			auto path		= _Archive::normalize(file_path);
+			const auto hash	= _Archive::hash(path);
+
+			const auto it = lookup.find(hash);
+			if (it != lookup.end())
+			{
+				if (paths[it->second] == path)
+					continue;
+
+				LOGF_ERROR("\"%s\" and \"%s\" have the same hash, rename one of them", paths[it->second].c_str(), path.c_str());
+				return false;
+			}
+
+			lookup[hash] = static_cast<uint32_t>(toc.size());
+			auto& entry			= toc.emplace_back();
+			entry				= {};
+			entry.path_hash		= hash;
+			entry.path_offset	= static_cast<uint32_t>(strings.size());
+			entry.path_length	= static_cast<uint32_t>(path.size());
+			strings				+= path;
+			paths.emplace_back(move(path));
+			paths_source.emplace_back(file_path);
+		}
+
+		_Archive::Header header	= {};
+		memcpy(header.magic, _Archive::magic, sizeof(header.magic));
+		header.version			= _Archive::version;
+		header.entry_count		= static_cast<uint32_t>(toc.size());
+		header.alignment		= _Archive::alignment;
+		header.toc_offset		= sizeof(_Archive::Header);
+		header.strings_offset	= header.toc_offset + toc.size() * sizeof(_Archive::TocEntry);
+		header.strings_size		= strings.size();
+
+		ofstream file(archive_path, ios::binary | ios::trunc);
+		if (!file.is_open())
+		{
+			LOGF_ERROR("Failed to open \"%s\" for writing", archive_path.c_str());
+			return false;
+		}
+
+		// The table of contents is written again once the offsets and sizes are known
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(toc.data()), toc.size() * sizeof(_Archive::TocEntry));
+		file.write(strings.data(), strings.size());
+
+		vector<std::byte> data;
+		const char padding[_Archive::alignment] = {};
+		auto offset = header.strings_offset + header.strings_size;
+		for (uint32_t i = 0; i < static_cast<uint32_t>(toc.size()); i++)
+		{
+			if (!_Archive::read_file(paths_source[i], &data))
+			{
+				LOGF_ERROR("Failed to read \"%s\"", paths_source[i].c_str());
+				file.close();
+				FileSystem::DeleteFile_(archive_path);
+				return false;
+			}
+
+			auto& entry				= toc[i];
+			entry.size_uncompressed	= data.size();
+			entry.compression		= Archive_Compression_None;
+			if (compress && !data.empty())
+			{
+				auto compressed = _Archive::compress(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+				if (compressed.size() <= data.size() - data.size() / 8)
+				{
+					data.swap(compressed);
+					entry.compression = Archive_Compression_LZ4;
+				}
+			}
+
+			const auto aligned = (offset + _Archive::alignment - 1) & ~static_cast<uint64_t>(_Archive::alignment - 1);
+			file.write(padding, aligned - offset);
+			file.write(reinterpret_cast<const char*>(data.data()), data.size());
+			entry.offset	= aligned;
+			entry.size		= data.size();
+			offset			= aligned + data.size();
+		}
+
+		file.seekp(header.toc_offset);
+		file.write(reinterpret_cast<const char*>(toc.data()), toc.size() * sizeof(_Archive::TocEntry));
+		file.flush();
+		if (file.fail())
+		{
+			LOGF_ERROR("Failed to write \"%s\"", archive_path.c_str());
+			file.close();
+			FileSystem::DeleteFile_(archive_path);
+			return false;
+		}
+
+		LOGF_INFO("Packed %u files into \"%s\"", header.entry_count, archive_path.c_str());
+		return true;
+	}
+
+	bool Archive::Mount(const string& archive_path)
+	{
+		auto archive = shared_ptr<Archive>(new Archive());
+		if (!archive->Load(archive_path))
+			return false;
+
+		// Mounting again moves the archive to the front
+		const auto path = _Archive::normalize(archive_path);
+		lock_guard<mutex> lock(_Archive::mount_mutex);
+		_Archive::mounted.erase(remove_if(_Archive::mounted.begin(), _Archive::mounted.end(), [&path](const shared_ptr<Archive>& mounted) { return mounted->m_path == path; }), _Archive::mounted.end());
+		archive->m_path = path;
+		_Archive::mounted.insert(_Archive::mounted.begin(), move(archive));
+		_Archive::any_mounted = true;
+		return true;
+	}
+
+	bool Archive::Unmount(const string& archive_path)
+	{
+		const auto path		= _Archive::normalize(archive_path);
+		lock_guard<mutex> lock(_Archive::mount_mutex);
+		const auto count	= _Archive::mounted.size();
+		_Archive::mounted.erase(remove_if(_Archive::mounted.begin(), _Archive::mounted.end(), [&path](const shared_ptr<Archive>& mounted) { return mounted->m_path == path; }), _Archive::mounted.end());
+		_Archive::any_mounted = !_Archive::mounted.empty();
+		return _Archive::mounted.size() != count;
+	}
+
+	void Archive::UnmountAll()
+	{
+		lock_guard<mutex> lock(_Archive::mount_mutex);
+		_Archive::mounted.clear();
+		_Archive::any_mounted = false;
+	}
+
+	bool Archive::Exists(const string& file_path)
+	{
+		ArchiveEntry entry;
+		return Find(file_path, &entry);
+	}
+
+	bool Archive::Find(const string& file_path, ArchiveEntry* entry)
+	{
+		if (!_Archive::any_mounted)
+			return false;
+
+		const auto path = _Archive::normalize(file_path);
+		const auto hash = _Archive::hash(path);
+
+		lock_guard<mutex> lock(_Archive::mount_mutex);
+		for (const auto& archive : _Archive::mounted)
+		{
+			if (archive->Find(hash, path, entry))
+				return true;
+		}
+
+		return false;
+	}
+
+	bool Archive::Read(const string& file_path, vector<std::byte>* data)
+	{
+		ArchiveEntry entry;
+		return Find(file_path, &entry) && Read(entry, data);
+	}
+
+	bool Archive::Read(const ArchiveEntry& entry, vector<std::byte>* data)
+	{
+		if (!entry.data || !data)
+			return false;
+
+		if (!entry.IsCompressed())
+		{
+			data->assign(entry.data, entry.data + entry.size);
+			return true;
+		}
+
+		data->resize(entry.size_uncompressed);
+		if (!_Archive::decompress(reinterpret_cast<const uint8_t*>(entry.data), entry.size, reinterpret_cast<uint8_t*>(data->data()), data->size()))
+		{
+			LOG_ERROR("Failed to decompress, the archive is corrupt");
+			data->clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Archive::Load(const string& archive_path)
+	{
+		m_mapping = make_shared<FileMapping>();
+		if (!m_mapping->Open(archive_path, false))
+		{
+			LOGF_ERROR("Failed to open \"%s\"", archive_path.c_str());
+			return false;
+		}
+
+		// Validate everything that is read later, so that lookups don't have to
+		const auto data = m_mapping->GetData();
+		const auto size = m_mapping->GetSize();
+		_Archive::Header header;
+		if (size < sizeof(header))
+		{
+			LOGF_ERROR("\"%s\" is not an archive", archive_path.c_str());
+			return false;
+		}
+		memcpy(&header, data, sizeof(header));
+
+		if (memcmp(header.magic, _Archive::magic, sizeof(header.magic)) != 0 || header.version != _Archive::version)
+		{
+			LOGF_ERROR("\"%s\" is not an archive, or it was created by a different version", archive_path.c_str());
+			return false;
+		}
+
+		const auto toc_size = static_cast<uint64_t>(header.entry_count) * sizeof(_Archive::TocEntry);
+		if (header.toc_offset % alignof(_Archive::TocEntry) != 0 || header.toc_offset > size || toc_size > size - header.toc_offset || header.strings_offset > size || header.strings_size > size - header.strings_offset)
+		{
+			LOGF_ERROR("\"%s\" is corrupt", archive_path.c_str());
+			return false;
+		}
+
+		const auto toc	= reinterpret_cast<const _Archive::TocEntry*>(data + header.toc_offset);
+		m_toc			= toc;
+		m_strings		= reinterpret_cast<const char*>(data + header.strings_offset);
+		m_lookup.reserve(header.entry_count);
+		for (uint32_t i = 0; i < header.entry_count; i++)
+		{
+			const auto& entry = toc[i];
+			if (entry.offset > size || entry.size > size - entry.offset || static_cast<uint64_t>(entry.path_offset) + entry.path_length > header.strings_size || entry.compression > Archive_Compression_LZ4 || (entry.compression == Archive_Compression_None && entry.size != entry.size_uncompressed))
+			{
+				LOGF_ERROR("\"%s\" is corrupt", archive_path.c_str());
+				return false;
+			}
+
+			m_lookup[entry.path_hash] = i;
+		}
+
+		return true;
+	}
+
+	bool Archive::Find(const uint64_t path_hash, const string& path, ArchiveEntry* entry) const
+	{
+		const auto it = m_lookup.find(path_hash);
+		if (it == m_lookup.end())
+			return false;
+
+		// A different path with the same hash
+		const auto& toc_entry = static_cast<const _Archive::TocEntry*>(m_toc)[it->second];
+		if (path.compare(0, string::npos, m_strings + toc_entry.path_offset, toc_entry.path_length) != 0)
+			return false;
+
+		entry->mapping				= m_mapping;
+		entry->data					= m_mapping->GetData() + toc_entry.offset;
+		entry->size					= toc_entry.size;
+		entry->size_uncompressed	= toc_entry.size_uncompressed;
+		entry->compression			= static_cast<Archive_Compression>(toc_entry.compression);
+		return true;
+	}
+}
@@ -0,0 +1,87 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==========
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "FileMapping.h"
+//=====================
+
+namespace Spartan
+{
+	enum Archive_Compression : uint32_t
+	{
+		Archive_Compression_None,
+		Archive_Compression_LZ4 // LZ4 block format
+	};
+
+	// Where a file lives inside a mounted archive. The mapping is shared, so the data stays valid even if the archive is unmounted.
+	struct ArchiveEntry
+	{
+		std::shared_ptr<FileMapping> mapping;
+		const std::byte* data				= nullptr;
+		uint64_t size						= 0;
+		uint64_t size_uncompressed			= 0;
+		Archive_Compression compression		= Archive_Compression_None;
+
+		auto IsCompressed() const { return compression != Archive_Compression_None; }
+	};
+
+	// Many files packed into one, so that loading them is a single open and a hash lookup per file instead of an open and a
+	// stat per file. Layout: header, table of contents, path strings, then the file data with every file aligned so that it
+	// can be used straight from the mapping. Mounted archives are searched before the file system by the engine's loaders.
+	class SPARTAN_CLASS Archive
+	{
+	public:
+		~Archive() = default;
+
+		// Packs the files, they are looked up with the paths they are given with. Files which don't shrink by at least
+		// an eighth when compressed are stored as they are.
+		static bool Create(const std::string& archive_path, const std::vector<std::string>& file_paths, bool compress = true);
+
+		// Archives mounted later take precedence over the ones mounted before them
+		static bool Mount(const std::string& archive_path);
+		static bool Unmount(const std::string& archive_path);
+		static void UnmountAll();
+
+		static bool Exists(const std::string& file_path);
+		static bool Find(const std::string& file_path, ArchiveEntry* entry);
+
+		// Copies the file out (decompressing it if needed)
+		static bool Read(const std::string& file_path, std::vector<std::byte>* data);
+		static bool Read(const ArchiveEntry& entry, std::vector<std::byte>* data);
+
+	private:
+		Archive() = default;
+		bool Load(const std::string& archive_path);
+		bool Find(uint64_t path_hash, const std::string& path, ArchiveEntry* entry) const;
+
+		std::string m_path;
+		std::shared_ptr<FileMapping> m_mapping;
+		const void* m_toc		= nullptr;
+		const char* m_strings	= nullptr;
+		std::unordered_map<uint64_t, uint32_t> m_lookup;
+	};
+}
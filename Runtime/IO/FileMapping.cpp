@@ -0,0 +1,109 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ========================
+#include "FileMapping.h"
+#include "../FileSystem/FileSystem.h"
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+//===================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	bool FileMapping::Open(const string& path, const bool sequential /*= true*/)
+	{
+		Close();
+
+		#ifdef _WIN32
+		const auto file = CreateFileW(FileSystem::StringToWstring(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER file_size;
+		void* view = nullptr;
+		if (GetFileSizeEx(file, &file_size) && file_size.QuadPart != 0)
+		{
+			// The view keeps the mapping and the file open, so their handles can be closed right away
+			if (const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+			{
+				view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				CloseHandle(mapping);
+			}
+		}
+		CloseHandle(file);
+
+		if (!view)
+			return false;
+
+		m_data = static_cast<const std::byte*>(view);
+		m_size = static_cast<uint64_t>(file_size.QuadPart);
+		return true;
+		#else
+		const auto file = open(path.c_str(), O_RDONLY);
+		if (file == -1)
+			return false;
+
+		struct stat file_stat;
+		void* view = MAP_FAILED;
+		if (fstat(file, &file_stat) == 0 && file_stat.st_size != 0)
+		{
+			view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+			if (view != MAP_FAILED)
+			{
+				madvise(view, static_cast<size_t>(file_stat.st_size), sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+			}
+		}
+		close(file);
+
+		if (view == MAP_FAILED)
+			return false;
+
+		m_data = static_cast<const std::byte*>(view);
+		m_size = static_cast<uint64_t>(file_stat.st_size);
+		return true;
+		#endif
+	}
+
+	void FileMapping::Close()
+	{
+		if (!m_data)
+			return;
+
+		#ifdef _WIN32
+		UnmapViewOfFile(m_data);
+		#else
+		munmap(const_cast<std::byte*>(m_data), static_cast<size_t>(m_size));
+		#endif
+
+		m_data = nullptr;
+		m_size = 0;
+	}
+}
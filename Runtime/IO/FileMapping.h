@@ -0,0 +1,55 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include "../Core/EngineDefs.h"
+//==============================
+
+namespace Spartan
+{
+	// A read only view of a whole file. Empty files can't be mapped.
+	class SPARTAN_CLASS FileMapping
+	{
+	public:
+		FileMapping() = default;
+		~FileMapping() { Close(); }
+
+		FileMapping(const FileMapping&)				= delete;
+		FileMapping& operator=(const FileMapping&)	= delete;
+
+		// Sequential access lets the OS read ahead aggressively, archives are read from all over the place
+		bool Open(const std::string& path, bool sequential = true);
+		void Close();
+
+		auto IsOpen() const		{ return m_data != nullptr; }
+		auto GetData() const	{ return m_data; }
+		auto GetSize() const	{ return m_size; }
+
+	private:
+		const std::byte* m_data	= nullptr;
+		uint64_t m_size			= 0;
+	};
+}
@@ -19,10 +19,13 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
-//= INCLUDES ==============
+//= INCLUDES ========================
 #include "FileStream.h"
+#include <cstring>
+#include "Archive.h"
 #include "../Logging/Log.h"
-//=========================
+#include "../FileSystem/FileSystem.h"
+//===================================
 
 //= NAMESPACES =====
 using namespace std;
@@ -51,6 +54,45 @@ namespace Spartan
 		}
 		else if (m_flags & FileStream_Read)
 		{
+			// Files in a mounted archive are read from its mapping, or decompressed into memory
+			ArchiveEntry entry;
+			if (Archive::Find(path, &entry))
+			{
+				if (entry.IsCompressed())
+				{
+					if (!Archive::Read(entry, &m_memory))
+					{
+						LOGF_ERROR("Failed to read \"%s\" from its archive", path.c_str());
+						return;
+					}
+
+					m_map_data = m_memory.data();
+					m_map_size = m_memory.size();
+				}
+				else
+				{
+					m_mapping	= move(entry.mapping);
+					m_map_data	= entry.data;
+					m_map_size	= entry.size;
+				}
+
+				m_is_open = true;
+				return;
+			}
+
+			if (m_flags & FileStream_Mapped)
+			{
+				auto mapping = make_shared<FileMapping>();
+				if (mapping->Open(path))
+				{
+					m_mapping	= move(mapping);
+					m_map_data	= m_mapping->GetData();
+					m_map_size	= m_mapping->GetSize();
+					m_is_open	= true;
+					return;
+				}
+			}
+
 			in.open(path, ios_flags);
 			if(in.fail())
 			{
@@ -62,6 +104,15 @@ namespace Spartan
 		m_is_open = true;
 	}
 
+	FileStream::FileStream(vector<std::byte>&& data)
+	{
+		m_flags		= FileStream_Read;
+		m_memory	= move(data);
+		m_map_data	= m_memory.data();
+		m_map_size	= m_memory.size();
+		m_is_open	= !m_memory.empty();
+	}
+
 	FileStream::~FileStream()
 	{
 		Close();
@@ -76,9 +127,20 @@ namespace Spartan
 		}
 		else if (m_flags & FileStream_Read)
 		{
+			if (m_map_data)
+			{
+				m_mapping.reset();
+				m_memory.clear();
+				m_map_data		= nullptr;
+				m_map_size		= 0;
+				m_map_position	= 0;
+			}
+
 			in.clear();
 			in.close();
 		}
+
+		m_view_storage.clear();
 	}
 
 	void FileStream::Write(const string& value)
@@ -137,7 +199,14 @@ namespace Spartan
 		}
 		else if (m_flags & FileStream_Read)
 		{
-			in.ignore(n, ios::cur);
+			if (m_map_data)
+			{
+				m_map_position = Math::Helper::Min(m_map_position + n, m_map_size);
+			}
+			else
+			{
+				in.ignore(n, ios::cur);
+			}
 		}
 	}
 
@@ -146,8 +215,15 @@ namespace Spartan
 		uint32_t length = 0;
 		Read(&length);
 
-		value->resize(length);
-		in.read(const_cast<char*>(value->c_str()), length);
+		if (const auto data = m_map_data ? ReadBytes(length) : nullptr)
+		{
+			value->assign(reinterpret_cast<const char*>(data), length);
+		}
+		else
+		{
+			value->resize(length);
+			ReadBytes(value->data(), length);
+		}
 	}
 
 	void FileStream::Read(vector<string>* vec)
@@ -171,65 +247,90 @@ namespace Spartan
 
 	void FileStream::Read(vector<RHI_Vertex_PosTexNorTan>* vec)
 	{
-		if (!vec)
-			return;
-
-		vec->clear();
-		vec->shrink_to_fit();
-
-		auto length = ReadAs<uint32_t>();
-
-		vec->reserve(length);
-		vec->resize(length);
-
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(RHI_Vertex_PosTexNorTan) * length);
+		ReadVector(vec);
 	}
 
 	void FileStream::Read(vector<uint32_t>* vec)
 	{
-		if (!vec)
-			return;
-
-		vec->clear();
-		vec->shrink_to_fit();
-
-		auto length = ReadAs<uint32_t>();
+		ReadVector(vec);
+	}
 
-		vec->reserve(length);
-		vec->resize(length);
+	void FileStream::Read(vector<unsigned char>* vec)
+	{
+		ReadVector(vec);
+	}
 
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(uint32_t) * length);
+	void FileStream::Read(vector<std::byte>* vec)
+	{
+		ReadVector(vec);
 	}
 
-	void FileStream::Read(vector<unsigned char>* vec)
+	void FileStream::ReadBytes(void* destination, const uint64_t size)
 	{
-		if (!vec)
+		if (!m_map_data)
+		{
+			in.read(static_cast<char*>(destination), size);
 			return;
+		}
 
-		vec->clear();
-		vec->shrink_to_fit();
+		if (const auto data = ReadBytes(size))
+		{
+			memcpy(destination, data, size);
+		}
+		else
+		{
+			memset(destination, 0, size);
+		}
+	}
 
-		auto length = ReadAs<uint32_t>();
+	const std::byte* FileStream::ReadBytes(const uint64_t size)
+	{
+		if (!m_map_data)
+		{
+			auto& storage = m_view_storage.emplace_back(size);
+			in.read(reinterpret_cast<char*>(storage.data()), size);
+			return storage.data();
+		}
 
-		vec->reserve(length);
-		vec->resize(length);
+		if (size > m_map_size - m_map_position)
+		{
+			LOGF_ERROR("Attempted to read %llu bytes, only %llu are left", static_cast<unsigned long long>(size), static_cast<unsigned long long>(m_map_size - m_map_position));
+			m_map_position = m_map_size;
+			return nullptr;
+		}
 
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(unsigned char) * length);
+		const auto data	= m_map_data + m_map_position;
+		m_map_position	+= size;
+		return data;
 	}
 
-	void FileStream::Read(vector<std::byte>* vec)
+	template <typename T>
+	void FileStream::ReadVector(vector<T>* vec)
 	{
 		if (!vec)
 			return;
 
-		vec->clear();
-		vec->shrink_to_fit();
+		const auto length = ReadAs<uint32_t>();
 
-		auto length = ReadAs<uint32_t>();
+		// A mapped file is copied from once, into memory of the exact size. The data isn't
+		// necessarily aligned for T within the file, so it's copied as bytes.
+		if (m_map_data)
+		{
+			const auto size = static_cast<uint64_t>(length) * sizeof(T);
+			const auto data = ReadBytes(size);
+			if (!data)
+			{
+				vec->clear();
+				return;
+			}
 
-		vec->reserve(length);
-		vec->resize(length);
+			vec->resize(length);
+			memcpy(vec->data(), data, size);
+			return;
+		}
 
-		in.read(reinterpret_cast<char*>(vec->data()), sizeof(std::byte) * length);
+		vec->clear();
+		vec->resize(length);
+		in.read(reinterpret_cast<char*>(vec->data()), sizeof(T) * length);
 	}
 }
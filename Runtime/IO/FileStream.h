@@ -23,7 +23,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ===================
 #include <vector>
+#include <memory>
 #include <fstream>
+#include "FileMapping.h"
 #include "../Math/Vector2.h"
 #include "../Math/Vector3.h"
 #include "../Math/Vector4.h"
@@ -40,15 +42,32 @@ namespace Spartan
 		FileStream_Read		= 1 << 0,
 		FileStream_Write	= 1 << 1,
 		FileStream_Append	= 1 << 2,
+		FileStream_Mapped	= 1 << 3, // reading only, the file is mapped into memory instead of streamed
+	};
+
+	// A read only array which points into a file (or into memory which the stream owns)
+	template <typename T>
+	struct FileStreamView
+	{
+		const T* data	= nullptr;
+		uint32_t count	= 0;
+
+		auto begin()	const { return data; }
+		auto end()		const { return data + count; }
+		auto empty()	const { return count == 0; }
+		auto size()		const { return count; }
 	};
 
 	class SPARTAN_CLASS FileStream
 	{
 	public:
 		FileStream(const std::string& path, uint32_t flags);
+		// Reads from memory the same way it reads from a mapped file, e.g. data which was streamed in
+		FileStream(std::vector<std::byte>&& data);
 		~FileStream();
 
-		auto IsOpen() const { return m_is_open; }
+		auto IsOpen() const		{ return m_is_open; }
+		auto IsMapped() const	{ return m_map_data != nullptr; }
 		void Close();
 
 		//= WRITING ==================================================
@@ -108,7 +127,7 @@ namespace Spartan
 		>::type>
 		void Read(T* value)
 		{
-			in.read(reinterpret_cast<char*>(value), sizeof(T));
+			ReadBytes(value, sizeof(T));
 		}
 		void Read(std::string* value);
 		void Read(std::vector<std::string>* vec);
@@ -117,6 +136,21 @@ namespace Spartan
 		void Read(std::vector<unsigned char>* vec);
 		void Read(std::vector<std::byte>* vec);
 
+		// Bulk reading, for mip data. When the file is mapped the view points straight into it, otherwise the data is read
+		// into memory which the stream owns. Either way, it's valid until the stream is closed. Arrays in a file are not
+		// aligned, so only byte views are handed out, typed arrays are copied out with Read(std::vector<T>*).
+		template <class T, class = typename std::enable_if
+		<
+			std::is_same<T, unsigned char>::value	||
+			std::is_same<T, std::byte>::value
+		>::type>
+		FileStreamView<T> ReadView()
+		{
+			const auto count	= ReadAs<uint32_t>();
+			const auto data		= ReadBytes(static_cast<uint64_t>(count));
+			return data ? FileStreamView<T>{ reinterpret_cast<const T*>(data), count } : FileStreamView<T>{};
+		}
+
 		// Reading with explicit type definition
 		template <class T, class = typename std::enable_if
 		<
@@ -143,9 +177,26 @@ namespace Spartan
 		//=====================================================
 
 	private:
+		void ReadBytes(void* destination, uint64_t size);
+		const std::byte* ReadBytes(uint64_t size);
+		template <typename T>
+		void ReadVector(std::vector<T>* vec);
+
 		std::ofstream out;
 		std::ifstream in;
 		uint32_t m_flags;
 		bool m_is_open;
+
+		// Mapped, the data is either the whole mapping or a file inside a mapped archive
+		std::shared_ptr<FileMapping> m_mapping;
+		const std::byte* m_map_data	= nullptr;
+		uint64_t m_map_size			= 0;
+		uint64_t m_map_position		= 0;
+
+		// Owned data which is read from as if it was mapped
+		std::vector<std::byte> m_memory;
+
+		// Where views point to when the file isn't mapped
+		std::vector<std::vector<std::byte>> m_view_storage;
 	};
 }
@@ -0,0 +1,345 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ======================
+#include "Streaming.h"
+#include <fstream>
+#include <algorithm>
+#include "Archive.h"
+#include "../Core/Context.h"
+#include "../Threading/Threading.h"
+#include "../Logging/Log.h"
+//=================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	namespace _Streaming
+	{
+		// Reading a gap of this size is cheaper than seeking over it and issuing another read
+		static const uint64_t coalesce_gap = 64 * 1024;
+	}
+
+	Streaming::Streaming(Context* context) : ISubsystem(context)
+	{
+
+	}
+
+	Streaming::~Streaming()
+	{
+		// Drop the reads which haven't started, they never call back
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stopping = true;
+			for (auto& requests : m_requests)
+			{
+				for (const auto& request : requests)
+				{
+					if (request.counter)
+					{
+						request.counter->Decrement();
+					}
+					m_pending.Decrement();
+				}
+				requests.clear();
+			}
+		}
+		m_condition_var.notify_all();
+
+		if (m_thread.joinable())
+		{
+			m_thread.join();
+		}
+
+		// Callbacks which are already on the job system may still be running
+		if (m_threading)
+		{
+			m_threading->Wait(m_pending);
+		}
+	}
+
+	bool Streaming::Initialize()
+	{
+		m_threading = m_context->GetSubsystem<Threading>();
+		if (!m_threading)
+		{
+			LOG_ERROR("Requires the threading subsystem");
+			return false;
+		}
+
+		m_thread = thread(&Streaming::Process, this);
+		return true;
+	}
+
+	uint64_t Streaming::Read(const string& file_path, const uint64_t offset, const uint64_t size, const Streaming_Priority priority, StreamingCallback&& callback, TaskCounter* counter /*= nullptr*/)
+	{
+		if (file_path.empty() || !callback || priority >= Streaming_Priority_Count)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return 0;
+		}
+
+		uint64_t id = 0;
+		{
+			lock_guard<mutex> lock(m_mutex);
+			if (m_stopping)
+				return 0;
+
+			id = m_id_next++;
+
+			auto& request		= m_requests[priority].emplace_back();
+			request.id			= id;
+			request.file_path	= file_path;
+			request.offset		= offset;
+			request.size		= size;
+			request.callback	= move(callback);
+			request.counter		= counter;
+			m_pending.Increment();
+			if (counter)
+			{
+				counter->Increment();
+			}
+		}
+		m_condition_var.notify_one();
+
+		return id;
+	}
+
+	bool Streaming::Cancel(const uint64_t id)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		for (auto& requests : m_requests)
+		{
+			const auto it = find_if(requests.begin(), requests.end(), [id](const Request& request) { return request.id == id; });
+			if (it != requests.end())
+			{
+				if (it->counter)
+				{
+					it->counter->Decrement();
+				}
+				requests.erase(it);
+				m_pending.Decrement();
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool Streaming::SetPriority(const uint64_t id, const Streaming_Priority priority)
+	{
+		if (priority >= Streaming_Priority_Count)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		lock_guard<mutex> lock(m_mutex);
+		for (auto& requests : m_requests)
+		{
+			const auto it = find_if(requests.begin(), requests.end(), [id](const Request& request) { return request.id == id; });
+			if (it != requests.end())
+			{
+				if (&requests != &m_requests[priority])
+				{
+					m_requests[priority].emplace_back(move(*it));
+					requests.erase(it);
+				}
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void Streaming::Wait()
+	{
+		if (!m_threading)
+			return;
+
+		m_threading->Wait(m_pending);
+	}
+
+	void Streaming::Wait(const TaskCounter& counter)
+	{
+		if (!m_threading)
+			return;
+
+		m_threading->Wait(counter);
+	}
+
+	void Streaming::Process()
+	{
+		vector<Request> batch;
+		while (true)
+		{
+			{
+				unique_lock<mutex> lock(m_mutex);
+				m_condition_var.wait(lock, [this]
+				{
+					return m_stopping || any_of(m_requests.begin(), m_requests.end(), [](const deque<Request>& requests) { return !requests.empty(); });
+				});
+
+				if (m_stopping)
+					return;
+
+				// Take the oldest read of the highest priority, along with the other reads of the same file
+				// and priority, so that the ones which are close to each other can be merged
+				auto& requests = *find_if(m_requests.begin(), m_requests.end(), [](const deque<Request>& requests) { return !requests.empty(); });
+				batch.emplace_back(move(requests.front()));
+				requests.pop_front();
+				for (auto it = requests.begin(); it != requests.end();)
+				{
+					if (it->file_path == batch.front().file_path)
+					{
+						batch.emplace_back(move(*it));
+						it = requests.erase(it);
+					}
+					else
+					{
+						++it;
+					}
+				}
+			}
+
+			ProcessBatch(batch);
+			batch.clear();
+		}
+	}
+
+	void Streaming::ProcessBatch(vector<Request>& batch)
+	{
+		// Files in a mounted archive are already mapped, reading them is a copy out of the mapping (or out of the decompressed file)
+		ArchiveEntry entry;
+		vector<std::byte> decompressed;
+		ifstream file;
+		const auto in_archive = Archive::Find(batch.front().file_path, &entry);
+		bool opened;
+		if (in_archive)
+		{
+			opened = !entry.IsCompressed() || Archive::Read(entry, &decompressed);
+		}
+		else
+		{
+			file.open(batch.front().file_path, ios::binary | ios::ate);
+			opened = file.is_open();
+		}
+
+		if (!opened)
+		{
+			LOGF_ERROR("Failed to open \"%s\"", batch.front().file_path.c_str());
+			for (auto& request : batch)
+			{
+				Complete(request, vector<std::byte>(), false);
+			}
+			return;
+		}
+
+		// Resolve reads which go to the end of the file and fail the ones which go past it
+		const auto file_size = in_archive ? entry.size_uncompressed : static_cast<uint64_t>(file.tellg());
+		for (auto it = batch.begin(); it != batch.end();)
+		{
+			if (it->size == 0 && it->offset < file_size)
+			{
+				it->size = file_size - it->offset;
+			}
+
+			if (it->size == 0 || it->offset + it->size > file_size)
+			{
+				LOGF_ERROR("Failed to read %llu bytes at %llu from \"%s\", which is %llu bytes", static_cast<unsigned long long>(it->size), static_cast<unsigned long long>(it->offset), it->file_path.c_str(), static_cast<unsigned long long>(file_size));
+				Complete(*it, vector<std::byte>(), false);
+				it = batch.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		if (in_archive)
+		{
+			const auto data = entry.IsCompressed() ? decompressed.data() : entry.data;
+			for (auto& request : batch)
+			{
+				Complete(request, vector<std::byte>(data + request.offset, data + request.offset + request.size), true);
+			}
+			return;
+		}
+
+		// Merge the reads into spans, a span ends where the next read starts too far away
+		sort(batch.begin(), batch.end(), [](const Request& a, const Request& b) { return a.offset < b.offset; });
+		for (uint32_t first = 0; first < static_cast<uint32_t>(batch.size());)
+		{
+			auto span_start	= batch[first].offset;
+			auto span_end	= span_start + batch[first].size;
+			auto last		= first + 1;
+			while (last < static_cast<uint32_t>(batch.size()) && batch[last].offset <= span_end + _Streaming::coalesce_gap)
+			{
+				span_end = max(span_end, batch[last].offset + batch[last].size);
+				last++;
+			}
+
+			vector<std::byte> data(span_end - span_start);
+			file.seekg(span_start);
+			file.read(reinterpret_cast<char*>(data.data()), data.size());
+			const auto success = static_cast<uint64_t>(file.gcount()) == data.size();
+			file.clear();
+
+			if (last - first == 1)
+			{
+				// A read on its own keeps the memory it was read into
+				Complete(batch[first], move(data), success);
+			}
+			else
+			{
+				for (auto i = first; i < last; i++)
+				{
+					const auto begin = data.begin() + (batch[i].offset - span_start);
+					Complete(batch[i], vector<std::byte>(begin, begin + batch[i].size), success);
+				}
+			}
+
+			first = last;
+		}
+	}
+
+	void Streaming::Complete(Request& request, vector<std::byte>&& data, const bool success)
+	{
+		StreamingResult result;
+		result.file_path	= move(request.file_path);
+		result.offset		= request.offset;
+		result.data			= success ? move(data) : vector<std::byte>();
+		result.success		= success;
+
+		m_threading->AddTask([this, callback = move(request.callback), result = move(result), counter = request.counter]() mutable
+		{
+			callback(result);
+			if (counter)
+			{
+				counter->Decrement();
+			}
+			m_pending.Decrement();
+		});
+	}
+}
@@ -0,0 +1,114 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include <deque>
+#include <array>
+#include <mutex>
+#include <thread>
+#include <string>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+#include "../Core/ISubsystem.h"
+#include "../Threading/Task.h"
+//=============================
+
+namespace Spartan
+{
+	enum Streaming_Priority
+	{
+		Streaming_Critical,	// Something is waiting for it
+		Streaming_Visible,	// Needed for what's on screen
+		Streaming_Prefetch,	// Might be needed soon
+		Streaming_Priority_Count
+	};
+
+	struct StreamingResult
+	{
+		std::string file_path;
+		uint64_t offset	= 0;
+		std::vector<std::byte> data;
+		bool success	= false;
+	};
+
+	using StreamingCallback = std::function<void(StreamingResult& result)>;
+
+	// Reads files on a dedicated thread, so that waiting on the disk doesn't take a worker away from the job system.
+	// Reads are served by priority and in order of submission within a priority, reads of the same file which are
+	// adjacent (or overlap) become a single read. Callbacks run on the job system.
+	class SPARTAN_CLASS Streaming : public ISubsystem
+	{
+	public:
+		Streaming(Context* context);
+		~Streaming();
+
+		//= Subsystem =============
+		bool Initialize() override;
+		//=========================
+
+		// Queues a read of size bytes at offset, a size of zero reads to the end of the file. If a counter is provided it will be incremented
+		// now and decremented once the callback has executed (or the read is cancelled). Returns an id which can be used to cancel or
+		// reprioritize the read, or zero if it couldn't be queued.
+		uint64_t Read(const std::string& file_path, uint64_t offset, uint64_t size, Streaming_Priority priority, StreamingCallback&& callback, TaskCounter* counter = nullptr);
+		uint64_t Read(const std::string& file_path, const Streaming_Priority priority, StreamingCallback&& callback, TaskCounter* counter = nullptr) { return Read(file_path, 0, 0, priority, std::move(callback), counter); }
+
+		// Both only affect reads which haven't started yet and return false otherwise. A cancelled read never calls back.
+		bool Cancel(uint64_t id);
+		bool SetPriority(uint64_t id, Streaming_Priority priority);
+
+		// Block until every queued read (or the reads of a counter) has called back, the calling thread executes pending jobs while waiting.
+		// Callbacks must not wait for the reads they belong to.
+		void Wait();
+		void Wait(const TaskCounter& counter);
+
+		uint32_t GetPendingCount() const { return m_pending.GetCount(); }
+
+	private:
+		struct Request
+		{
+			uint64_t id		= 0;
+			std::string file_path;
+			uint64_t offset	= 0;
+			uint64_t size	= 0;
+			StreamingCallback callback;
+			TaskCounter* counter = nullptr;
+		};
+
+		// This function is invoked by the I/O thread
+		void Process();
+		void ProcessBatch(std::vector<Request>& batch);
+		void Complete(Request& request, std::vector<std::byte>&& data, bool success);
+
+		std::thread m_thread;
+		std::array<std::deque<Request>, Streaming_Priority_Count> m_requests;
+		std::mutex m_mutex;
+		std::condition_variable m_condition_var;
+		bool m_stopping			= false;
+		uint64_t m_id_next		= 1;
+
+		// Queued and in flight reads, including the ones whose callbacks haven't finished
+		TaskCounter m_pending;
+		Threading* m_threading	= nullptr;
+	};
+}
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ========================
 #include "XmlDocument.h"
 #include "pugixml.hpp"
+#include "Archive.h"
 #include "../Logging/Log.h"
 #include "../Math/Vector2.h"
 #include "../Math/Vector3.h"
@@ -257,7 +258,10 @@ namespace Spartan
 	bool XmlDocument::Load(const string& filePath)
 	{
 		m_document = make_unique<xml_document>();
-		xml_parse_result result = m_document->load_file(filePath.c_str());
+
+		// Mounted archives come first
+		vector<std::byte> data;
+		xml_parse_result result = Archive::Read(filePath, &data) ? m_document->load_buffer(data.data(), data.size()) : m_document->load_file(filePath.c_str());
 
 		if (result.status != status_ok)
 		{
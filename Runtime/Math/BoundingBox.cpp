@@ -116,7 +116,7 @@ namespace Spartan::Math
 		m_min.y = Min(m_min.y, box.m_min.y);
 		m_min.z = Min(m_min.z, box.m_min.z);
 		m_max.x = Max(m_max.x, box.m_max.x);
-		m_max.y = Max(m_max.x, box.m_max.x);
-		m_max.z = Max(m_max.x, box.m_max.x);
+		m_max.y = Max(m_max.y, box.m_max.y);
+		m_max.z = Max(m_max.z, box.m_max.z);
 	}
 }
\ No newline at end of file
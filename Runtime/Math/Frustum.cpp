@@ -22,9 +22,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =======
 #include "Frustum.h"
 #include "Plane.h"
+#include <limits>
 //==================
 
 //= NAMESPACES ========================
+using namespace std;
 using namespace Spartan::Math::Helper;
 //=====================================
 
@@ -85,7 +87,43 @@ namespace Spartan::Math
 		m_planes[5].Normalize();
 	}
 
-	Intersection Frustum::CheckCube(const Vector3& center, const Vector3& extent)
+	void Frustum::Construct(const Matrix& view_projection)
+	{
+		const auto& vp = view_projection;
+
+		// 0 <= z
+		m_planes[0] = Plane(Vector3(vp.m02, vp.m12, vp.m22), vp.m32);
+		// z <= w
+		m_planes[1] = Plane(Vector3(vp.m03 - vp.m02, vp.m13 - vp.m12, vp.m23 - vp.m22), vp.m33 - vp.m32);
+		// -w <= x <= w
+		m_planes[2] = Plane(Vector3(vp.m03 + vp.m00, vp.m13 + vp.m10, vp.m23 + vp.m20), vp.m33 + vp.m30);
+		m_planes[3] = Plane(Vector3(vp.m03 - vp.m00, vp.m13 - vp.m10, vp.m23 - vp.m20), vp.m33 - vp.m30);
+		// -w <= y <= w
+		m_planes[4] = Plane(Vector3(vp.m03 - vp.m01, vp.m13 - vp.m11, vp.m23 - vp.m21), vp.m33 - vp.m31);
+		m_planes[5] = Plane(Vector3(vp.m03 + vp.m01, vp.m13 + vp.m11, vp.m23 + vp.m21), vp.m33 + vp.m31);
+
+		for (auto& plane : m_planes)
+		{
+			plane.Normalize();
+		}
+	}
+
+	void Frustum::Extrude(const Vector3& direction)
+	{
+		const auto direction_normalized = direction.Normalized();
+		for (auto& plane : m_planes)
+		{
+			// Any plane facing away from the direction would reject casters lying towards it, so it's opened.
+			// Planes parallel to the direction are kept (the tolerance only absorbs rounding), an open plane never rejects anything.
+			if (plane.normal.Dot(direction_normalized) < -M_EPSILON)
+			{
+				plane.normal	= Vector3::Zero;
+				plane.d			= numeric_limits<float>::max();
+			}
+		}
+	}
+
+	Intersection Frustum::CheckCube(const Vector3& center, const Vector3& extent) const
 	{
 		// Check if any one point of the cube is in the view frustum.
 		Intersection result = Inside;
@@ -114,7 +152,78 @@ namespace Spartan::Math
 		return result;
 	}
 
-	Intersection Frustum::CheckSphere(const Vector3& center, float radius)
+	void Frustum::CheckCubes(const FrustumBoxes& boxes, vector<uint32_t>* visible) const
+	{
+		visible->clear();
+
+#if defined(SPARTAN_SIMD_SSE)
+		// Splat the planes once
+		__m128 normal_x[6], normal_y[6], normal_z[6], abs_x[6], abs_y[6], abs_z[6], distance_neg[6];
+		const __m128 sign_mask = _mm_set1_ps(-0.0f);
+		for (int i = 0; i < 6; i++)
+		{
+			normal_x[i]		= _mm_set1_ps(m_planes[i].normal.x);
+			normal_y[i]		= _mm_set1_ps(m_planes[i].normal.y);
+			normal_z[i]		= _mm_set1_ps(m_planes[i].normal.z);
+			abs_x[i]		= _mm_andnot_ps(sign_mask, normal_x[i]);
+			abs_y[i]		= _mm_andnot_ps(sign_mask, normal_y[i]);
+			abs_z[i]		= _mm_andnot_ps(sign_mask, normal_z[i]);
+			distance_neg[i]	= _mm_set1_ps(-m_planes[i].d);
+		}
+
+		for (uint32_t i = 0; i < boxes.count; i += 4)
+		{
+			const __m128 center_x = _mm_loadu_ps(&boxes.center_x[i]);
+			const __m128 center_y = _mm_loadu_ps(&boxes.center_y[i]);
+			const __m128 center_z = _mm_loadu_ps(&boxes.center_z[i]);
+			const __m128 extent_x = _mm_loadu_ps(&boxes.extent_x[i]);
+			const __m128 extent_y = _mm_loadu_ps(&boxes.extent_y[i]);
+			const __m128 extent_z = _mm_loadu_ps(&boxes.extent_z[i]);
+
+			// A box is outside if it's fully behind any plane
+			__m128 outside = _mm_setzero_ps();
+			for (int p = 0; p < 6; p++)
+			{
+				const __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(center_x, normal_x[p]), _mm_mul_ps(center_y, normal_y[p])), _mm_mul_ps(center_z, normal_z[p]));
+				const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(extent_x, abs_x[p]), _mm_mul_ps(extent_y, abs_y[p])), _mm_mul_ps(extent_z, abs_z[p]));
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), distance_neg[p]));
+			}
+
+			int mask = ~_mm_movemask_ps(outside) & 0xF;
+			while (mask)
+			{
+				const uint32_t lane = (mask & 1) ? 0 : (mask & 2) ? 1 : (mask & 4) ? 2 : 3;
+				mask &= mask - 1;
+				if (i + lane < boxes.count)
+				{
+					visible->emplace_back(i + lane);
+				}
+			}
+		}
+#else
+		for (uint32_t i = 0; i < boxes.count; i++)
+		{
+			bool outside = false;
+			for (const auto& plane : m_planes)
+			{
+				const float d = boxes.center_x[i] * plane.normal.x + boxes.center_y[i] * plane.normal.y + boxes.center_z[i] * plane.normal.z;
+				const float r = boxes.extent_x[i] * Abs(plane.normal.x) + boxes.extent_y[i] * Abs(plane.normal.y) + boxes.extent_z[i] * Abs(plane.normal.z);
+				if (d + r < -plane.d)
+				{
+					outside = true;
+					break;
+				}
+			}
+
+			if (!outside)
+			{
+				visible->emplace_back(i);
+			}
+		}
+#endif
+	}
+
+	Intersection Frustum::CheckSphere(const Vector3& center, float radius) const
 	{
 		// calculate our distances to each of the planes
 		for (const auto& plane : m_planes)
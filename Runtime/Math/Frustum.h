@@ -22,13 +22,53 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES =============
+#include <vector>
 #include "../Math/Plane.h"
 #include "Matrix.h"
 #include "Vector3.h"
+#include "BoundingBox.h"
 //========================
 
 namespace Spartan::Math
 {
+	// Boxes as center/extent components in separate arrays, so that several of them can be tested at once
+	struct FrustumBoxes
+	{
+		void Clear() { count = 0; Resize(0); }
+
+		void Resize(const uint32_t box_count)
+		{
+			// Pad to a multiple of 4, the padding is never reported as visible
+			const uint32_t size = (box_count + 3) & ~3U;
+			center_x.resize(size); center_y.resize(size); center_z.resize(size);
+			extent_x.resize(size); extent_y.resize(size); extent_z.resize(size);
+			count = box_count;
+		}
+
+		void Set(const uint32_t index, const BoundingBox& box)
+		{
+			const Vector3 center	= box.GetCenter();
+			const Vector3 extent	= box.GetExtents();
+			center_x[index] = center.x; center_y[index] = center.y; center_z[index] = center.z;
+			extent_x[index] = extent.x; extent_y[index] = extent.y; extent_z[index] = extent.z;
+		}
+
+		// Copies the box at from over the one at to, for swap-and-pop removal
+		void Copy(const uint32_t from, const uint32_t to)
+		{
+			center_x[to] = center_x[from]; center_y[to] = center_y[from]; center_z[to] = center_z[from];
+			extent_x[to] = extent_x[from]; extent_y[to] = extent_y[from]; extent_z[to] = extent_z[from];
+		}
+
+		uint32_t count = 0;
+		std::vector<float> center_x;
+		std::vector<float> center_y;
+		std::vector<float> center_z;
+		std::vector<float> extent_x;
+		std::vector<float> extent_y;
+		std::vector<float> extent_z;
+	};
+
 	class Frustum
 	{
 	public:
@@ -36,8 +76,16 @@ namespace Spartan::Math
 		~Frustum() {}
 
 		void Construct(const Matrix& mView, const Matrix&  mProjection, float screenDepth);
-		Intersection CheckCube(const Vector3& center, const Vector3& extent);
-		Intersection CheckSphere(const Vector3& center, float radius);
+		// Planes straight from a view projection with depth in [0, 1], works for orthographic and reversed depth projections
+		void Construct(const Matrix& view_projection);
+		// Opens the planes that face away from direction, so the volume extends infinitely towards it.
+		// Meant for directional light (orthographic) frustums, where casters can be anywhere towards the light.
+		void Extrude(const Vector3& direction);
+		Intersection CheckCube(const Vector3& center, const Vector3& extent) const;
+		Intersection CheckSphere(const Vector3& center, float radius) const;
+
+		// Writes the indices of the boxes that are not fully outside (four boxes per iteration)
+		void CheckCubes(const FrustumBoxes& boxes, std::vector<uint32_t>* visible) const;
 
 	private:
 		Plane m_planes[6];
@@ -37,6 +37,30 @@ namespace Spartan::Math
 		0, 0, 0, 1
 	);
 
+	void Matrix::Multiply(const Matrix* lhs, const Matrix* rhs, Matrix* out, const uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+#if defined(SPARTAN_SIMD_SSE) || defined(SPARTAN_SIMD_NEON)
+			SIMD::MatrixMultiply(lhs[i].Data(), rhs[i].Data(), out[i].Data());
+#else
+			out[i] = lhs[i] * rhs[i];
+#endif
+		}
+	}
+
+	void Matrix::TransformPoints(const Matrix& matrix, const Vector3* in, Vector3* out, const uint32_t count)
+	{
+#if defined(SPARTAN_SIMD_SSE)
+		SIMD::MatrixTransformPoints(matrix.Data(), &in->x, &out->x, count, sizeof(Vector3) / sizeof(float));
+#else
+		for (uint32_t i = 0; i < count; i++)
+		{
+			out[i] = matrix * in[i];
+		}
+#endif
+	}
+
 	string Matrix::ToString() const
 	{
 		char tempBuffer[200];
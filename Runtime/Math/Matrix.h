@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Quaternion.h"
 #include "Vector3.h"
 #include "Vector4.h"
+#include "SIMD.h"
 //=====================
 
 //= NAMESPACES ========================
@@ -33,7 +34,7 @@ using namespace Spartan::Math::Helper;
 
 namespace Spartan::Math
 {
-	class SPARTAN_CLASS Matrix
+	class SPARTAN_CLASS alignas(16) Matrix
 	{
 	public:
 		Matrix()
@@ -41,13 +42,8 @@ namespace Spartan::Math
 			SetIdentity();
 		}
 
-		Matrix (const Matrix& rhs)
-		{
-			m00 = rhs.m00; m01 = rhs.m01; m02 = rhs.m02; m03 = rhs.m03;
-			m10 = rhs.m10; m11 = rhs.m11; m12 = rhs.m12; m13 = rhs.m13;
-			m20 = rhs.m20; m21 = rhs.m21; m22 = rhs.m22; m23 = rhs.m23;
-			m30 = rhs.m30; m31 = rhs.m31; m32 = rhs.m32; m33 = rhs.m33;
-		}
+		// Trivially copyable, so matrices can be memcpy'd into GPU buffers
+		Matrix(const Matrix& rhs) = default;
 
 		Matrix(
 			float m00, float m01, float m02, float m03,
@@ -71,10 +67,10 @@ namespace Spartan::Math
 			m30 = translation.x; m31 = translation.y; m32 = translation.z; m33 = 1.0f;
 		}
 
-		~Matrix() {}
+		~Matrix() = default;
 
 		//= TRANSLATION ===========================================
-		Vector3 GetTranslation() { return Vector3(m30, m31, m32); }
+		Vector3 GetTranslation() const { return Vector3(m30, m31, m32); }
 
 		static Matrix CreateTranslation(const Vector3& position)
 		{
@@ -120,7 +116,7 @@ namespace Spartan::Math
 			);
 		}
 
-		Quaternion GetRotation()
+		Quaternion GetRotation() const
 		{
 			Vector3 scale = GetScale();
 
@@ -193,8 +189,13 @@ namespace Spartan::Math
 		//================================================================================================
 
 		//= SCALE ========================================================================================
-		Vector3 GetScale()
+		Vector3 GetScale() const
 		{
+#if defined(SPARTAN_SIMD_SSE)
+			Vector3 scale;
+			SIMD::MatrixScale(Data(), &scale.x);
+			return scale;
+#else
 			int xs = (Sign(m00 * m01 * m02 * m03) < 0) ? -1 : 1;
             int ys = (Sign(m10 * m11 * m12 * m13) < 0) ? -1 : 1;
             int zs = (Sign(m20 * m21 * m22 * m23) < 0) ? -1 : 1;
@@ -204,6 +205,7 @@ namespace Spartan::Math
 				(float)ys * Sqrt(m10 * m10 + m11 * m11 + m12 * m12),
 				(float)zs * Sqrt(m20 * m20 + m21 * m21 + m22 * m22)
 			);
+#endif
 		}
 
 		static Matrix CreateScale(float scale) { return CreateScale(scale, scale, scale); }
@@ -290,6 +292,11 @@ namespace Spartan::Math
 		Matrix Inverted() const { return Invert(*this); }
 		static Matrix Invert(const Matrix& matrix)
 		{
+#if defined(SPARTAN_SIMD_SSE)
+			Matrix result;
+			SIMD::MatrixInvert(matrix.Data(), result.Data());
+			return result;
+#else
 			float v0 = matrix.m20 * matrix.m31 - matrix.m21 * matrix.m30;
 			float v1 = matrix.m20 * matrix.m32 - matrix.m22 * matrix.m30;
 			float v2 = matrix.m20 * matrix.m33 - matrix.m23 *matrix.m30;
@@ -343,10 +350,11 @@ namespace Spartan::Math
 				i10, i11, i12, i13,
 				i20, i21, i22, i23,
 				i30, i31, i32, i33);
+#endif
 		}
 		//================================================================================================
 
-		void Decompose(Vector3& scale, Quaternion& rotation, Vector3& translation)
+		void Decompose(Vector3& scale, Quaternion& rotation, Vector3& translation) const
 		{
 			translation = GetTranslation();
 			scale		= GetScale();
@@ -364,6 +372,11 @@ namespace Spartan::Math
 		//= MULTIPLICATION ================================================================================================================
 		Matrix operator*(const Matrix& rhs) const
 		{
+#if defined(SPARTAN_SIMD_SSE) || defined(SPARTAN_SIMD_NEON)
+			Matrix result;
+			SIMD::MatrixMultiply(Data(), rhs.Data(), result.Data());
+			return result;
+#else
 			return Matrix(
 				m00 * rhs.m00 + m01 * rhs.m10 + m02 * rhs.m20 + m03 * rhs.m30,
 				m00 * rhs.m01 + m01 * rhs.m11 + m02 * rhs.m21 + m03 * rhs.m31,
@@ -382,10 +395,14 @@ namespace Spartan::Math
 				m30 * rhs.m02 + m31 * rhs.m12 + m32 * rhs.m22 + m33 * rhs.m32,
 				m30 * rhs.m03 + m31 * rhs.m13 + m32 * rhs.m23 + m33 * rhs.m33
 			);
+#endif
 		}
 
 		void operator*=(const Matrix& rhs) { (*this) = (*this) * rhs; }
 
+		// out[i] = lhs[i] * rhs[i], out may alias either input
+		static void Multiply(const Matrix* lhs, const Matrix* rhs, Matrix* out, uint32_t count);
+
 		Vector3 operator *(const Vector3& rhs) const
 		{
 			Vector4 vWorking;
@@ -397,6 +414,9 @@ namespace Spartan::Math
 
 			return Vector3(vWorking.x * vWorking.w, vWorking.y * vWorking.w, vWorking.z * vWorking.w);
 		}
+
+		// out[i] = in[i] * matrix, out may alias in
+		static void TransformPoints(const Matrix& matrix, const Vector3* in, Vector3* out, uint32_t count);
 		//=================================================================================================================================
 
 		//= COMPARISON =================================================
@@ -417,7 +437,8 @@ namespace Spartan::Math
 		bool operator!=(const Matrix& b) const { return !(*this == b); }
 		//==============================================================
 
-		const float* Data() const { return &m00; }
+		const float* Data() const	{ return &m00; }
+		float* Data()				{ return &m00; }
 		std::string ToString() const;
 
 		// Column-major memory representation 
@@ -26,7 +26,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Core/Context.h"
 #include "../World/World.h"
 #include "../World/Entity.h"
-#include "../World/Components/Skybox.h"
 #include "../World/Components/Renderable.h"
 //=========================================
 
@@ -45,27 +44,23 @@ namespace Spartan::Math
 
 	vector<RayHit> Ray::Trace(Context* context) const
 	{
-		// Find all the entities that the ray hits
+		// Find all the entities that the ray hits (the world's spatial index skips the skybox)
+		vector<Entity*> entities;
+		context->GetSubsystem<World>()->QueryRay(*this, &entities);
+
 		vector<RayHit> hits;
-		const auto& entities = context->GetSubsystem<World>()->EntityGetAll();
+		hits.reserve(entities.size());
 		for (const auto& entity : entities)
 		{
-			// Make sure there entity has a mesh and exclude the SkyBox
-			if (!entity->HasComponent<Renderable>() || entity->HasComponent<Skybox>())
-				continue;
-
-			// Get bounding box
-			auto aabb = entity->GetComponent<Renderable>()->GeometryAabb();
-
 			// Compute hit distance
-			auto hit_distance = HitDistance(aabb);
+			const auto hit_distance = HitDistance(entity->GetRenderable_PtrRaw()->GeometryAabb());
 
 			// Don't store hit data if there was no hit
 			if (hit_distance == INFINITY)
 				continue;
 
-			auto inside	= (hit_distance == 0.0f);
-			hits.emplace_back(entity, hit_distance, inside);
+			const auto inside = (hit_distance == 0.0f);
+			hits.emplace_back(entity->GetPtrShared(), hit_distance, inside);
 		}
 
 		// Sort by distance (ascending)
@@ -0,0 +1,209 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+// Picks a vector instruction set at compile time, define SPARTAN_SIMD_DISABLED to force the scalar paths
+#if !defined(SPARTAN_SIMD_DISABLED)
+	#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define SPARTAN_SIMD_SSE
+	#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+		#define SPARTAN_SIMD_NEON
+	#endif
+#endif
+
+//= INCLUDES ===========
+#include <cstdint>
+#if defined(SPARTAN_SIMD_SSE)
+	#include <emmintrin.h>
+#elif defined(SPARTAN_SIMD_NEON)
+	#include <arm_neon.h>
+#endif
+//======================
+
+// All functions operate on 4x4 matrices stored as 16 floats, column by column (the Math::Matrix layout).
+// Unaligned loads are used throughout, so any float array is accepted.
+namespace Spartan::Math::SIMD
+{
+#if defined(SPARTAN_SIMD_SSE)
+	#define SPARTAN_SIMD_SHUFFLE(v, x, y, z, w) _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x))
+
+	// out = lhs * rhs, out may alias either input
+	inline void MatrixMultiply(const float* lhs, const float* rhs, float* out)
+	{
+		const __m128 c0 = _mm_loadu_ps(lhs);
+		const __m128 c1 = _mm_loadu_ps(lhs + 4);
+		const __m128 c2 = _mm_loadu_ps(lhs + 8);
+		const __m128 c3 = _mm_loadu_ps(lhs + 12);
+
+		for (int i = 0; i < 4; i++)
+		{
+			const __m128 b = _mm_loadu_ps(rhs + i * 4);
+			__m128 r = _mm_mul_ps(c0, SPARTAN_SIMD_SHUFFLE(b, 0, 0, 0, 0));
+			r = _mm_add_ps(r, _mm_mul_ps(c1, SPARTAN_SIMD_SHUFFLE(b, 1, 1, 1, 1)));
+			r = _mm_add_ps(r, _mm_mul_ps(c2, SPARTAN_SIMD_SHUFFLE(b, 2, 2, 2, 2)));
+			r = _mm_add_ps(r, _mm_mul_ps(c3, SPARTAN_SIMD_SHUFFLE(b, 3, 3, 3, 3)));
+			_mm_storeu_ps(out + i * 4, r);
+		}
+	}
+
+	// 2x2 helpers for the block wise inverse, a 2x2 matrix is packed as (m00, m01, m10, m11)
+	inline __m128 Mat2Mul(const __m128 a, const __m128 b)
+	{
+		return _mm_add_ps(_mm_mul_ps(a, SPARTAN_SIMD_SHUFFLE(b, 0, 3, 0, 3)), _mm_mul_ps(SPARTAN_SIMD_SHUFFLE(a, 1, 0, 3, 2), SPARTAN_SIMD_SHUFFLE(b, 2, 1, 2, 1)));
+	}
+
+	// adjugate(a) * b
+	inline __m128 Mat2AdjMul(const __m128 a, const __m128 b)
+	{
+		return _mm_sub_ps(_mm_mul_ps(SPARTAN_SIMD_SHUFFLE(a, 3, 3, 0, 0), b), _mm_mul_ps(SPARTAN_SIMD_SHUFFLE(a, 1, 1, 2, 2), SPARTAN_SIMD_SHUFFLE(b, 2, 3, 0, 1)));
+	}
+
+	// a * adjugate(b)
+	inline __m128 Mat2MulAdj(const __m128 a, const __m128 b)
+	{
+		return _mm_sub_ps(_mm_mul_ps(a, SPARTAN_SIMD_SHUFFLE(b, 3, 0, 3, 0)), _mm_mul_ps(SPARTAN_SIMD_SHUFFLE(a, 1, 0, 3, 2), SPARTAN_SIMD_SHUFFLE(b, 2, 1, 2, 1)));
+	}
+
+	// General 4x4 inverse using 2x2 blocks. The inverse of the transpose is the transpose
+	// of the inverse, so the same code works regardless of row or column storage.
+	inline void MatrixInvert(const float* in, float* out)
+	{
+		const __m128 r0 = _mm_loadu_ps(in);
+		const __m128 r1 = _mm_loadu_ps(in + 4);
+		const __m128 r2 = _mm_loadu_ps(in + 8);
+		const __m128 r3 = _mm_loadu_ps(in + 12);
+
+		// Sub matrices
+		const __m128 a = _mm_movelh_ps(r0, r1);
+		const __m128 b = _mm_movehl_ps(r1, r0);
+		const __m128 c = _mm_movelh_ps(r2, r3);
+		const __m128 d = _mm_movehl_ps(r3, r2);
+
+		// Determinants of the sub matrices as (|A| |B| |C| |D|)
+		const __m128 det_sub = _mm_sub_ps
+		(
+			_mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+			_mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0)))
+		);
+		const __m128 det_a = SPARTAN_SIMD_SHUFFLE(det_sub, 0, 0, 0, 0);
+		const __m128 det_b = SPARTAN_SIMD_SHUFFLE(det_sub, 1, 1, 1, 1);
+		const __m128 det_c = SPARTAN_SIMD_SHUFFLE(det_sub, 2, 2, 2, 2);
+		const __m128 det_d = SPARTAN_SIMD_SHUFFLE(det_sub, 3, 3, 3, 3);
+
+		const __m128 d_c = Mat2AdjMul(d, c);
+		const __m128 a_b = Mat2AdjMul(a, b);
+		__m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), Mat2Mul(b, d_c));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), Mat2Mul(c, a_b));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), Mat2MulAdj(d, a_b));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), Mat2MulAdj(a, d_c));
+
+		// |M| = |A|*|D| + |B|*|C| - trace((A#B)(D#C))
+		__m128 trace = _mm_mul_ps(a_b, SPARTAN_SIMD_SHUFFLE(d_c, 0, 2, 1, 3));
+		trace = _mm_add_ps(trace, SPARTAN_SIMD_SHUFFLE(trace, 2, 3, 0, 1));
+		trace = _mm_add_ps(trace, SPARTAN_SIMD_SHUFFLE(trace, 1, 0, 3, 2));
+		const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), trace);
+
+		const __m128 det_rcp = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+		x = _mm_mul_ps(x, det_rcp);
+		y = _mm_mul_ps(y, det_rcp);
+		z = _mm_mul_ps(z, det_rcp);
+		w = _mm_mul_ps(w, det_rcp);
+
+		// Apply the adjugate while storing
+		_mm_storeu_ps(out,		_mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_storeu_ps(out + 4,	_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+		_mm_storeu_ps(out + 8,	_mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+		_mm_storeu_ps(out + 12,	_mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+	}
+
+	// Signed length of the first three rows, as in Matrix::GetScale()
+	inline void MatrixScale(const float* in, float* out_xyz)
+	{
+		const __m128 c0 = _mm_loadu_ps(in);
+		const __m128 c1 = _mm_loadu_ps(in + 4);
+		const __m128 c2 = _mm_loadu_ps(in + 8);
+		const __m128 c3 = _mm_loadu_ps(in + 12);
+
+		const __m128 length	= _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, c0), _mm_mul_ps(c1, c1)), _mm_mul_ps(c2, c2)));
+		const __m128 sign	= _mm_and_ps(_mm_cmplt_ps(_mm_mul_ps(_mm_mul_ps(c0, c1), _mm_mul_ps(c2, c3)), _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+
+		float result[4];
+		_mm_storeu_ps(result, _mm_xor_ps(length, sign));
+		out_xyz[0] = result[0];
+		out_xyz[1] = result[1];
+		out_xyz[2] = result[2];
+	}
+
+	// Transforms count points (x, y, z, 1) and divides by w, as in Matrix::operator*(Vector3)
+	inline void MatrixTransformPoints(const float* matrix, const float* in_xyz, float* out_xyz, const uint32_t count, const uint32_t stride)
+	{
+		// Rows, so that a point becomes x * row0 + y * row1 + z * row2 + row3
+		__m128 r0 = _mm_loadu_ps(matrix);
+		__m128 r1 = _mm_loadu_ps(matrix + 4);
+		__m128 r2 = _mm_loadu_ps(matrix + 8);
+		__m128 r3 = _mm_loadu_ps(matrix + 12);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const float* p	= in_xyz + i * stride;
+			__m128 v		= _mm_add_ps(_mm_mul_ps(r0, _mm_set1_ps(p[0])), r3);
+			v				= _mm_add_ps(v, _mm_mul_ps(r1, _mm_set1_ps(p[1])));
+			v				= _mm_add_ps(v, _mm_mul_ps(r2, _mm_set1_ps(p[2])));
+			v				= _mm_div_ps(v, SPARTAN_SIMD_SHUFFLE(v, 3, 3, 3, 3));
+
+			float result[4];
+			_mm_storeu_ps(result, v);
+			float* o = out_xyz + i * stride;
+			o[0] = result[0];
+			o[1] = result[1];
+			o[2] = result[2];
+		}
+	}
+
+	#undef SPARTAN_SIMD_SHUFFLE
+#elif defined(SPARTAN_SIMD_NEON)
+	// out = lhs * rhs, out may alias either input
+	inline void MatrixMultiply(const float* lhs, const float* rhs, float* out)
+	{
+		const float32x4_t c0 = vld1q_f32(lhs);
+		const float32x4_t c1 = vld1q_f32(lhs + 4);
+		const float32x4_t c2 = vld1q_f32(lhs + 8);
+		const float32x4_t c3 = vld1q_f32(lhs + 12);
+
+		float32x4_t result[4];
+		for (int i = 0; i < 4; i++)
+		{
+			const float* b	= rhs + i * 4;
+			float32x4_t r	= vmulq_n_f32(c0, b[0]);
+			r				= vmlaq_n_f32(r, c1, b[1]);
+			r				= vmlaq_n_f32(r, c2, b[2]);
+			result[i]		= vmlaq_n_f32(r, c3, b[3]);
+		}
+
+		for (int i = 0; i < 4; i++)
+		{
+			vst1q_f32(out + i * 4, result[i]);
+		}
+	}
+#endif
+}
@@ -84,8 +84,8 @@ namespace Spartan
 
 	bool Physics::Initialize()
 	{
-		m_renderer = m_context->GetSubsystem<Renderer>().get();
-		m_profiler = m_context->GetSubsystem<Profiler>().get();
+		m_renderer = m_context->GetSubsystem<Renderer>();
+		m_profiler = m_context->GetSubsystem<Profiler>();
 
 		// Enabled debug drawing
 		m_debug_draw = new PhysicsDebugDraw(m_renderer);
@@ -39,6 +39,7 @@ namespace Spartan
 		m_metrics = NOT_ASSIGNED;
 		m_time_blocks.reserve(m_time_block_capacity);
 		m_time_blocks.resize(m_time_block_capacity);
+		m_main_thread_id = this_thread::get_id();
 
 		// Subscribe to events
 		SUBSCRIBE_TO_EVENT(Event_Frame_Start, EVENT_HANDLER(OnFrameStart));
@@ -47,9 +48,9 @@ namespace Spartan
 
 	bool Profiler::Initialize()
 	{
-		m_timer				= m_context->GetSubsystem<Timer>().get();
-		m_resource_manager	= m_context->GetSubsystem<ResourceCache>().get();
-		m_renderer			= m_context->GetSubsystem<Renderer>().get();
+		m_timer				= m_context->GetSubsystem<Timer>();
+		m_resource_manager	= m_context->GetSubsystem<ResourceCache>();
+		m_renderer			= m_context->GetSubsystem<Renderer>();
 
 		// Get available memory
 		if (const DisplayAdapter* adapter = m_renderer->GetRhiDevice()->GetPrimaryAdapter())
@@ -66,12 +67,14 @@ namespace Spartan
 		if (!m_should_update)
 			return false;
 
+		// GPU queries go through the immediate context, which only the main thread uses
 		bool can_profile_cpu = profile_cpu && m_profile_cpu_enabled;
-		bool can_profile_gpu = profile_gpu && m_profile_gpu_enabled;
+		bool can_profile_gpu = profile_gpu && m_profile_gpu_enabled && this_thread::get_id() == m_main_thread_id;
 
 		if (!can_profile_cpu && !can_profile_gpu)
 			return false;
 
+		lock_guard<mutex> lock(m_time_blocks_mutex);
 		if (auto time_block = GetNextTimeBlock())
 		{
 			auto time_block_parent = GetSecondLastIncompleteTimeBlock();
@@ -86,6 +89,7 @@ namespace Spartan
 		if (!m_should_update || m_time_block_count == 0)
 			return false;
 
+		lock_guard<mutex> lock(m_time_blocks_mutex);
 		if (auto time_block = GetLastIncompleteTimeBlock())
 		{
 			time_block->End(m_renderer->GetRhiDevice());
@@ -174,10 +178,11 @@ namespace Spartan
 
 	TimeBlock* Profiler::GetLastIncompleteTimeBlock()
 	{
+		const auto thread_id = this_thread::get_id();
 		for (int i = m_time_block_count - 1; i >= 0; i--)
 		{
 			TimeBlock& time_block = m_time_blocks[i];
-			if (!time_block.IsComplete())
+			if (!time_block.IsComplete() && time_block.GetThreadId() == thread_id)
 				return &time_block;
 		}
 
@@ -186,18 +191,14 @@ namespace Spartan
 
 	TimeBlock* Profiler::GetSecondLastIncompleteTimeBlock()
 	{
-		bool first_found = false;
-		for (int i = m_time_block_count - 1; i >= 0; i--)
+		// The last time block is the one being started, so look for the last incomplete one
+		// before it which was started on this thread (blocks from other threads can be interleaved)
+		const auto thread_id = this_thread::get_id();
+		for (int i = m_time_block_count - 2; i >= 0; i--)
 		{
 			TimeBlock& time_block = m_time_blocks[i];
-			if (!time_block.IsComplete())
-			{
-				if (first_found)
-				{
-					return &time_block;
-				}
-				first_found = true;		
-			}
+			if (!time_block.IsComplete() && time_block.GetThreadId() == thread_id)
+				return &time_block;
 		}
 
 		return nullptr;
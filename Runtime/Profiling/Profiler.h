@@ -24,6 +24,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==================
 #include <string>
 #include <vector>
+#include <mutex>
+#include <thread>
 #include "TimeBlock.h"
 #include "../Core/EngineDefs.h"
 #include "../Core/ISubsystem.h"
@@ -119,7 +121,9 @@ namespace Spartan
 		float m_profiling_interval_sec		= 0.3f;
 		float m_profiling_last_update_time	= m_profiling_interval_sec;
 
-		// Time blocks
+		// Time blocks (subsystems can tick on worker threads, so blocks are nested per thread)
+		std::mutex m_time_blocks_mutex;
+		std::thread::id m_main_thread_id;
 		uint32_t m_time_block_capacity	= 200;
 		uint32_t m_time_block_count		= 0;
 		std::vector<TimeBlock> m_time_blocks;
@@ -52,6 +52,7 @@ namespace Spartan
 		m_parent		= parent;
 		m_tree_depth	= FindTreeDepth(this);
 		m_rhi_device	= rhi_device.get();
+		m_thread_id		= this_thread::get_id();
 
 		if (profile_cpu)
 		{
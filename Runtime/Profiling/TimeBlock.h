@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 //===============
 
 namespace Spartan
@@ -47,6 +48,7 @@ namespace Spartan
 		const bool IsComplete() const		{ return m_is_complete; }
 		const std::string& GetName() const	{ return m_name; }
 		const TimeBlock* GetParent() const	{ return m_parent; }
+		std::thread::id GetThreadId() const	{ return m_thread_id; }
 		uint32_t GetTreeDepth()	const	{ return m_tree_depth; }
 		float GetDurationCpu() const		{ return m_duration_cpu; }
 		float GetDurationGpu() const		{ return m_duration_gpu; }
@@ -58,6 +60,7 @@ namespace Spartan
 		RHI_Device* m_rhi_device;
 		bool m_has_started			= false;
 		bool m_is_complete			= false;
+		std::thread::id m_thread_id;
 
 		// Hierarchy
 		const TimeBlock* m_parent	= nullptr;
@@ -26,276 +26,37 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ========================
 #include "../../Profiling/Profiler.h"
-#include "../../Logging/Log.h"
+#include "../../FileSystem/FileSystem.h"
 #include "../RHI_CommandList.h"
-#include "../RHI_Pipeline.h"
 #include "../RHI_Device.h"
-#include "../RHI_Sampler.h"
-#include "../RHI_Texture.h"
-#include "../RHI_Shader.h"
 #include "../RHI_ConstantBuffer.h"
-#include "../RHI_VertexBuffer.h"
-#include "../RHI_IndexBuffer.h"
-#include "../RHI_BlendState.h"
-#include "../RHI_DepthStencilState.h"
-#include "../RHI_RasterizerState.h"
-#include "../RHI_InputLayout.h"
+#include <cstring>
 //===================================
 
-//= NAMESPACES ===============
+//= NAMESPACES =====
 using namespace std;
-using namespace Spartan::Math;
-//============================
+//==================
 
 namespace Spartan
 {
-	RHI_CommandList::RHI_CommandList(const shared_ptr<RHI_Device>& rhi_device, Profiler* profiler)
-	{
-		m_commands.reserve(m_initial_capacity);
-		m_commands.resize(m_initial_capacity);
-		m_rhi_device	= rhi_device;
-		m_profiler		= profiler;
-	}
-
-	RHI_CommandList::~RHI_CommandList() = default;
-
-	void RHI_CommandList::Begin(const string& pass_name, void* render_pass, RHI_SwapChain* swap_chain)
-	{
-		auto& cmd			= GetCmd();
-		cmd.type			= RHI_Cmd_Begin;
-		cmd.pass_name		= pass_name;
-	}
-
-	void RHI_CommandList::End()
-	{
-		auto& cmd	= GetCmd();
-		cmd.type	= RHI_Cmd_End;
-	}
-
-	void RHI_CommandList::Draw(const uint32_t vertex_count)
-	{
-		auto& cmd			= GetCmd();
-		cmd.type			= RHI_Cmd_Draw;
-		cmd.vertex_count	= vertex_count;
-	}
-
-	void RHI_CommandList::DrawIndexed(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset)
-	{
-		auto& cmd			= GetCmd();
-		cmd.type			= RHI_Cmd_DrawIndexed;
-		cmd.index_count		= index_count;
-		cmd.index_offset	= index_offset;
-		cmd.vertex_offset	= vertex_offset;
-	}
-
-	void RHI_CommandList::SetPipeline(RHI_Pipeline* pipeline)
-	{
-		SetViewport(pipeline->GetState()->viewport);
-		SetBlendState(pipeline->GetState()->blend_state);
-		SetDepthStencilState(pipeline->GetState()->depth_stencil_state);
-		SetRasterizerState(pipeline->GetState()->rasterizer_state);
-		SetInputLayout(pipeline->GetState()->shader_vertex->GetInputLayout());
-		SetShaderVertex(pipeline->GetState()->shader_vertex);
-		SetShaderPixel(pipeline->GetState()->shader_pixel);
-		SetPrimitiveTopology(pipeline->GetState()->primitive_topology);
-	}
-
-	void RHI_CommandList::SetViewport(const RHI_Viewport& viewport)
-	{
-		auto& cmd		= GetCmd();
-		cmd.type		= RHI_Cmd_SetViewport;
-		cmd.viewport	= viewport;
-	}
-
-	void RHI_CommandList::SetScissorRectangle(const Math::Rectangle& scissor_rectangle)
-	{
-		auto& cmd				= GetCmd();
-		cmd.type				= RHI_Cmd_SetScissorRectangle;
-		cmd.scissor_rectangle	= scissor_rectangle;
-	}
-
-	void RHI_CommandList::SetPrimitiveTopology(const RHI_PrimitiveTopology_Mode primitive_topology)
-	{
-		auto& cmd				= GetCmd();
-		cmd.type				= RHI_Cmd_SetPrimitiveTopology;
-		cmd.primitive_topology	= primitive_topology;
-	}
-
-	void RHI_CommandList::SetInputLayout(const RHI_InputLayout* input_layout)
-	{
-		auto& cmd			= GetCmd();
-		cmd.type			= RHI_Cmd_SetInputLayout;
-		cmd.input_layout	= input_layout;
-	}
-
-	void RHI_CommandList::SetDepthStencilState(const RHI_DepthStencilState* depth_stencil_state)
-	{
-		auto& cmd				= GetCmd();
-		cmd.type				= RHI_Cmd_SetDepthStencilState;
-		cmd.depth_stencil_state = depth_stencil_state;
-	}
-
-	void RHI_CommandList::SetRasterizerState(const RHI_RasterizerState* rasterizer_state)
-	{
-		auto& cmd				= GetCmd();
-		cmd.type				= RHI_Cmd_SetRasterizerState;
-		cmd.rasterizer_state	= rasterizer_state;
-	}
-
-	void RHI_CommandList::SetBlendState(const RHI_BlendState* blend_state)
-	{
-		auto& cmd			= GetCmd();
-		cmd.type			= RHI_Cmd_SetBlendState;
-		cmd.blend_state		= blend_state;
-	}
-
-	void RHI_CommandList::SetBufferVertex(const RHI_VertexBuffer* buffer)
-	{
-		auto& cmd			= GetCmd();
-		cmd.type			= RHI_Cmd_SetVertexBuffer;
-		cmd.buffer_vertex	= buffer;
-	}
-
-	void RHI_CommandList::SetBufferIndex(const RHI_IndexBuffer* buffer)
-	{
-		auto& cmd			= GetCmd();
-		cmd.type			= RHI_Cmd_SetIndexBuffer;
-		cmd.buffer_index	= buffer;
-	}
-
-	void RHI_CommandList::SetShaderVertex(const RHI_Shader* shader)
-	{
-		auto& cmd			= GetCmd();
-		cmd.type			= RHI_Cmd_SetVertexShader;
-		cmd.shader_vertex	= shader;
-	}
-
-	void RHI_CommandList::SetShaderPixel(const RHI_Shader* shader)
-	{
-		auto& cmd			= GetCmd();
-		cmd.type			= RHI_Cmd_SetPixelShader;
-		cmd.shader_pixel	= shader;
-	}
-
-	void RHI_CommandList::SetConstantBuffers(const uint32_t start_slot, const RHI_Buffer_Scope scope, const vector<void*>& constant_buffers)
-	{
-		auto& cmd						= GetCmd();
-		cmd.type						= RHI_Cmd_SetConstantBuffers;
-		cmd.constant_buffers_start_slot = start_slot;
-		cmd.constant_buffers_scope		= scope;
-		cmd.constant_buffers			= constant_buffers;
-		cmd.constant_buffer_count		= static_cast<uint32_t>(constant_buffers.size());
-	}
-
-	void RHI_CommandList::SetConstantBuffer(const uint32_t start_slot, const RHI_Buffer_Scope scope, const shared_ptr<RHI_ConstantBuffer>& constant_buffer)
-	{
-		auto& cmd										= GetCmd();
-		cmd.type										= RHI_Cmd_SetConstantBuffers;
-		cmd.constant_buffers_start_slot					= start_slot;
-		cmd.constant_buffers_scope						= scope;
-		cmd.constant_buffers[cmd.constant_buffer_count] = constant_buffer->GetResource();
-		cmd.constant_buffer_count++;
-	}
-
-	void RHI_CommandList::SetSamplers(const uint32_t start_slot, const vector<void*>& samplers)
-	{
-		auto& cmd				= GetCmd();
-		cmd.type				= RHI_Cmd_SetSamplers;
-		cmd.samplers_start_slot = start_slot;
-		cmd.samplers			= samplers;
-		cmd.sampler_count		= static_cast<uint32_t>(samplers.size());
-	}
-
-	void RHI_CommandList::SetSampler(const uint32_t start_slot, const shared_ptr<RHI_Sampler>& sampler)
-	{
-		auto& cmd						= GetCmd();
-		cmd.type						= RHI_Cmd_SetSamplers;
-		cmd.samplers_start_slot			= start_slot;
-		cmd.samplers[cmd.sampler_count] = sampler->GetResource();
-		cmd.sampler_count++;
-	}
-
-	void RHI_CommandList::SetTextures(const uint32_t start_slot, const vector<void*>& textures)
-	{
-		auto& cmd				= GetCmd();
-		cmd.type				= RHI_Cmd_SetTextures;
-		cmd.textures_start_slot = start_slot;
-		cmd.textures			= textures;
-		cmd.texture_count		= static_cast<uint32_t>(textures.size());
-	}
-
-	void RHI_CommandList::SetTexture(const uint32_t start_slot, RHI_Texture* texture)
-	{
-		auto& cmd						= GetCmd();
-		cmd.type						= RHI_Cmd_SetTextures;
-		cmd.textures_start_slot			= start_slot;
-		cmd.textures[cmd.texture_count] = texture ? texture->GetResource_Texture() : nullptr;
-		cmd.texture_count++;
-	}
-
-	void RHI_CommandList::SetRenderTargets(const vector<void*>& render_targets, void* depth_stencil /*= nullptr*/)
-	{
-		auto& cmd				= GetCmd();
-		cmd.type				= RHI_Cmd_SetRenderTargets;
-		cmd.render_targets		= render_targets;
-		cmd.render_target_count = static_cast<uint32_t>(render_targets.size());
-		cmd.depth_stencil		= depth_stencil;
-	}
-
-	void RHI_CommandList::SetRenderTarget(void* render_target, void* depth_stencil /*= nullptr*/)
-	{
-		auto& cmd									= GetCmd();
-		cmd.type									= RHI_Cmd_SetRenderTargets;	
-		cmd.depth_stencil							= depth_stencil;
-		cmd.render_targets[cmd.render_target_count] = render_target;
-		cmd.render_target_count++;
-	}
-
-	void RHI_CommandList::SetRenderTarget(const shared_ptr<RHI_Texture>& render_target, void* depth_stencil /*= nullptr*/)
-	{
-		SetRenderTarget(render_target->GetResource_RenderTarget(), depth_stencil);
-	}
-
-	void RHI_CommandList::ClearRenderTarget(void* render_target, const Vector4& color)
-	{
-		auto& cmd						= GetCmd();
-		cmd.type						= RHI_Cmd_ClearRenderTarget;
-		cmd.render_target_clear			= render_target;
-		cmd.render_target_clear_color	= color;
-	}
-
-	void RHI_CommandList::ClearDepthStencil(void* depth_stencil, const uint32_t flags, const float depth, const uint32_t stencil /*= 0*/)
-	{
-		if (!depth_stencil)
-		{
-			LOG_ERROR("Provided depth stencil is null");
-			return;
-		}
-
-		auto& cmd				= GetCmd();
-		cmd.type				= RHI_Cmd_ClearDepthStencil;
-		cmd.depth_stencil		= depth_stencil;
-		cmd.depth_clear_flags	= flags;
-		cmd.depth_clear			= depth;
-		cmd.depth_clear_stencil = stencil;
-	}
-
 	bool RHI_CommandList::Submit()
 	{
-		auto context		= m_rhi_device->GetContext();
-		auto device_context	= m_rhi_device->GetContext()->device_context;
+		auto context			= m_rhi_device->GetContext();
+		auto device_context		= m_rhi_device->GetContext()->device_context;
+		auto device_context_1	= m_rhi_device->GetContext()->device_context_1;
 
-		for (uint32_t cmd_index = 0; cmd_index < m_command_count; cmd_index++)
-		{
-			auto& cmd = m_commands[cmd_index];
+		// Without constant buffer offsets the constants are uploaded one binding at a time
+		const auto constants_base = device_context_1 ? ConstantsUpload() : 0;
 
+		for (const auto& cmd : m_commands)
+		{
 			switch (cmd.type)
 			{
 				case RHI_Cmd_Begin:
 				{
-					m_profiler->TimeBlockStart(cmd.pass_name, true, true);
+					m_profiler->TimeBlockStart(*cmd.pass.name, true, true);
 					#ifdef DEBUG
-					context->annotation->BeginEvent(FileSystem::StringToWstring(cmd.pass_name).c_str());
+					context->annotation->BeginEvent(FileSystem::StringToWstring(*cmd.pass.name).c_str());
 					#endif
 					break;
 				}
@@ -311,7 +72,7 @@ namespace Spartan
 
 				case RHI_Cmd_Draw:
 				{
-					device_context->Draw(static_cast<UINT>(cmd.vertex_count), 0);
+					device_context->Draw(static_cast<UINT>(cmd.draw.vertex_count), 0);
 
 					m_profiler->m_rhi_draw_calls++;
 					break;
@@ -319,13 +80,30 @@ namespace Spartan
 
 				case RHI_Cmd_DrawIndexed:
 				{
-					SPARTAN_ASSERT(cmd.index_count != 0);
+					SPARTAN_ASSERT(cmd.draw.index_count != 0);
 
 					device_context->DrawIndexed
 					(
-						static_cast<UINT>(cmd.index_count),
-						static_cast<UINT>(cmd.index_offset),
-						static_cast<INT>(cmd.vertex_offset)
+						static_cast<UINT>(cmd.draw.index_count),
+						static_cast<UINT>(cmd.draw.index_offset),
+						static_cast<INT>(cmd.draw.vertex_offset)
+					);
+
+					m_profiler->m_rhi_draw_calls++;
+					break;
+				}
+
+				case RHI_Cmd_DrawIndexedInstanced:
+				{
+					SPARTAN_ASSERT(cmd.draw.index_count != 0 && cmd.draw.instance_count != 0);
+
+					device_context->DrawIndexedInstanced
+					(
+						static_cast<UINT>(cmd.draw.index_count),
+						static_cast<UINT>(cmd.draw.instance_count),
+						static_cast<UINT>(cmd.draw.index_offset),
+						static_cast<INT>(cmd.draw.vertex_offset),
+						static_cast<UINT>(cmd.draw.instance_offset)
 					);
 
 					m_profiler->m_rhi_draw_calls++;
@@ -335,12 +113,12 @@ namespace Spartan
 				case RHI_Cmd_SetViewport:
 				{
 					D3D11_VIEWPORT d3d11_viewport;
-					d3d11_viewport.TopLeftX	= cmd.viewport.GetX();
-					d3d11_viewport.TopLeftY	= cmd.viewport.GetY();
-					d3d11_viewport.Width	= cmd.viewport.GetWidth();
-					d3d11_viewport.Height	= cmd.viewport.GetHeight();
-					d3d11_viewport.MinDepth	= cmd.viewport.GetMinDepth();
-					d3d11_viewport.MaxDepth	= cmd.viewport.GetMaxDepth();
+					d3d11_viewport.TopLeftX	= cmd.viewport.x;
+					d3d11_viewport.TopLeftY	= cmd.viewport.y;
+					d3d11_viewport.Width	= cmd.viewport.width;
+					d3d11_viewport.Height	= cmd.viewport.height;
+					d3d11_viewport.MinDepth	= cmd.viewport.depth_min;
+					d3d11_viewport.MaxDepth	= cmd.viewport.depth_max;
 
 					device_context->RSSetViewports(1, &d3d11_viewport);
 
@@ -349,10 +127,10 @@ namespace Spartan
 
 				case RHI_Cmd_SetScissorRectangle:
 				{
-					const auto left		= cmd.scissor_rectangle.x;
-					const auto top		= cmd.scissor_rectangle.y;
-					const auto right	= cmd.scissor_rectangle.x + cmd.scissor_rectangle.width;
-					const auto bottom	= cmd.scissor_rectangle.y + cmd.scissor_rectangle.height;
+					const auto left		= cmd.rectangle.x;
+					const auto top		= cmd.rectangle.y;
+					const auto right	= cmd.rectangle.x + cmd.rectangle.width;
+					const auto bottom	= cmd.rectangle.y + cmd.rectangle.height;
 					const D3D11_RECT d3d11_rectangle = { static_cast<LONG>(left), static_cast<LONG>(top), static_cast<LONG>(right), static_cast<LONG>(bottom) };
 
 					device_context->RSSetScissorRects(1, &d3d11_rectangle);
@@ -362,30 +140,25 @@ namespace Spartan
 
 				case RHI_Cmd_SetPrimitiveTopology:
 				{
-					device_context->IASetPrimitiveTopology(d3d11_primitive_topology[cmd.primitive_topology]);
+					device_context->IASetPrimitiveTopology(d3d11_primitive_topology[cmd.topology.mode]);
 					break;
 				}
 
 				case RHI_Cmd_SetInputLayout:
 				{
-					device_context->IASetInputLayout(static_cast<ID3D11InputLayout*>(cmd.input_layout->GetResource()));
+					device_context->IASetInputLayout(static_cast<ID3D11InputLayout*>(cmd.state.resource));
 					break;
 				}
 
 				case RHI_Cmd_SetDepthStencilState:
 				{
-					device_context->OMSetDepthStencilState(
-						static_cast<ID3D11DepthStencilState*>(cmd.depth_stencil_state->GetBuffer()), 1
-					);
+					device_context->OMSetDepthStencilState(static_cast<ID3D11DepthStencilState*>(cmd.state.resource), 1);
 					break;
 				}
 
 				case RHI_Cmd_SetRasterizerState:
 				{
-					device_context->RSSetState(
-						static_cast<ID3D11RasterizerState*>(cmd.rasterizer_state->GetBuffer())
-					);
-
+					device_context->RSSetState(static_cast<ID3D11RasterizerState*>(cmd.state.resource));
 					break;
 				}
 
@@ -394,7 +167,7 @@ namespace Spartan
 					FLOAT blend_factor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
 
 					device_context->OMSetBlendState(
-						static_cast<ID3D11BlendState*>(cmd.blend_state->GetBuffer()),
+						static_cast<ID3D11BlendState*>(cmd.state.resource),
 						blend_factor,
 						0xffffffff
 					);
@@ -404,10 +177,10 @@ namespace Spartan
 
 				case RHI_Cmd_SetVertexBuffer:
 				{
-					auto ptr			= static_cast<ID3D11Buffer*>(cmd.buffer_vertex->GetResource());
-					auto stride			= cmd.buffer_vertex->GetStride();
-					uint32_t offset = 0;
-					device_context->IASetVertexBuffers(0, 1, &ptr, &stride, &offset);
+					auto ptr		= static_cast<ID3D11Buffer*>(cmd.buffer.resource);
+					auto stride		= static_cast<UINT>(cmd.buffer.stride);
+					UINT offset		= 0;
+					device_context->IASetVertexBuffers(static_cast<UINT>(cmd.buffer.slot), 1, &ptr, &stride, &offset);
 
 					m_profiler->m_rhi_bindings_buffer_vertex++;
 					break;
@@ -417,8 +190,8 @@ namespace Spartan
 				{
 					device_context->IASetIndexBuffer
 					(
-						static_cast<ID3D11Buffer*>(cmd.buffer_index->GetResource()),
-						cmd.buffer_index->Is16Bit() ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT,
+						static_cast<ID3D11Buffer*>(cmd.buffer.resource),
+						cmd.buffer.stride == 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT,
 						0
 					);
 
@@ -428,8 +201,7 @@ namespace Spartan
 
 				case RHI_Cmd_SetVertexShader:
 				{
-					const auto ptr = static_cast<ID3D11VertexShader*>(cmd.shader_vertex->GetResource_VertexShader());
-					device_context->VSSetShader(ptr, nullptr, 0);
+					device_context->VSSetShader(static_cast<ID3D11VertexShader*>(cmd.state.resource), nullptr, 0);
 
 					m_profiler->m_rhi_bindings_vertex_shader++;
 					break;
@@ -437,8 +209,7 @@ namespace Spartan
 
 				case RHI_Cmd_SetPixelShader:
 				{
-					const auto ptr = static_cast<ID3D11PixelShader*>(cmd.shader_pixel ? cmd.shader_pixel->GetResource_PixelShader() : nullptr);
-					device_context->PSSetShader(ptr, nullptr, 0);
+					device_context->PSSetShader(static_cast<ID3D11PixelShader*>(cmd.state.resource), nullptr, 0);
 
 					m_profiler->m_rhi_bindings_pixel_shader++;
 					break;
@@ -446,10 +217,10 @@ namespace Spartan
 
 				case RHI_Cmd_SetConstantBuffers:
 				{
-					const auto start_slot	= static_cast<UINT>(cmd.constant_buffers_start_slot);
-					const auto buffer_count = static_cast<UINT>(cmd.constant_buffer_count);
-					const auto buffer		= reinterpret_cast<ID3D11Buffer*const*>(cmd.constant_buffers.data());
-					const auto scope		= cmd.constant_buffers_scope;
+					const auto start_slot	= static_cast<UINT>(cmd.resources.start_slot);
+					const auto buffer_count = static_cast<UINT>(cmd.resources.count);
+					const auto buffer		= reinterpret_cast<ID3D11Buffer*const*>(m_command_resources.data() + cmd.resources.offset);
+					const auto scope		= cmd.resources.scope;
 
 					if (scope == Buffer_VertexShader || scope == Buffer_Global)
 					{
@@ -461,7 +232,68 @@ namespace Spartan
 						device_context->PSSetConstantBuffers(start_slot, buffer_count, buffer);
 					}
 
-					m_profiler->m_rhi_bindings_buffer_constant += (cmd.constant_buffers_scope == Buffer_Global) ? 2 : 1;
+					m_profiler->m_rhi_bindings_buffer_constant += (scope == Buffer_Global) ? 2 : 1;
+					break;
+				}
+
+				case RHI_Cmd_SetConstantBufferData:
+				{
+					const auto slot			= static_cast<UINT>(cmd.constants.slot);
+					const auto scope		= cmd.constants.scope;
+					auto first_constant		= static_cast<UINT>((constants_base + cmd.constants.offset) / 16);
+					auto constant_count		= static_cast<UINT>(cmd.constants.size / 16);
+					ID3D11Buffer* buffer	= nullptr;
+
+					if (device_context_1)
+					{
+						if (!m_constants_ring)
+							break;
+
+						buffer = static_cast<ID3D11Buffer*>(m_constants_ring->GetResource());
+					}
+					else
+					{
+						// Without constant buffer offsets, a buffer of the maximum size is discarded and filled for every binding
+						if (!m_constants_fallback)
+						{
+							m_constants_fallback = make_shared<RHI_ConstantBuffer>(m_rhi_device);
+							m_constants_fallback->Create(4096 * 16);
+						}
+
+						if (const auto data = m_constants_fallback->Map())
+						{
+							memcpy(data, m_constants.data() + cmd.constants.offset, cmd.constants.size);
+							m_constants_fallback->Unmap();
+						}
+
+						buffer = static_cast<ID3D11Buffer*>(m_constants_fallback->GetResource());
+					}
+
+					if (scope == Buffer_VertexShader || scope == Buffer_Global)
+					{
+						if (device_context_1)
+						{
+							device_context_1->VSSetConstantBuffers1(slot, 1, &buffer, &first_constant, &constant_count);
+						}
+						else
+						{
+							device_context->VSSetConstantBuffers(slot, 1, &buffer);
+						}
+					}
+
+					if (scope == Buffer_PixelShader || scope == Buffer_Global)
+					{
+						if (device_context_1)
+						{
+							device_context_1->PSSetConstantBuffers1(slot, 1, &buffer, &first_constant, &constant_count);
+						}
+						else
+						{
+							device_context->PSSetConstantBuffers(slot, 1, &buffer);
+						}
+					}
+
+					m_profiler->m_rhi_bindings_buffer_constant += (scope == Buffer_Global) ? 2 : 1;
 					break;
 				}
 
@@ -469,9 +301,9 @@ namespace Spartan
 				{
 					device_context->PSSetSamplers
 					(
-						static_cast<UINT>(cmd.samplers_start_slot),
-						static_cast<UINT>(cmd.sampler_count),
-						reinterpret_cast<ID3D11SamplerState* const*>(cmd.samplers.data())
+						static_cast<UINT>(cmd.resources.start_slot),
+						static_cast<UINT>(cmd.resources.count),
+						reinterpret_cast<ID3D11SamplerState* const*>(m_command_resources.data() + cmd.resources.offset)
 					);
 
 					m_profiler->m_rhi_bindings_sampler++;
@@ -482,9 +314,9 @@ namespace Spartan
 				{
 					device_context->PSSetShaderResources
 					(
-						static_cast<UINT>(cmd.textures_start_slot),
-						static_cast<UINT>(cmd.texture_count),
-						reinterpret_cast<ID3D11ShaderResourceView* const*>(cmd.textures.data())
+						static_cast<UINT>(cmd.resources.start_slot),
+						static_cast<UINT>(cmd.resources.count),
+						reinterpret_cast<ID3D11ShaderResourceView* const*>(m_command_resources.data() + cmd.resources.offset)
 					);
 
 					m_profiler->m_rhi_bindings_texture++;
@@ -495,9 +327,9 @@ namespace Spartan
 				{
 					device_context->OMSetRenderTargets
 					(
-						static_cast<UINT>(cmd.render_target_count),
-						reinterpret_cast<ID3D11RenderTargetView* const*>(cmd.render_targets.data()),
-						static_cast<ID3D11DepthStencilView*>(cmd.depth_stencil)
+						static_cast<UINT>(cmd.render_targets.count),
+						reinterpret_cast<ID3D11RenderTargetView* const*>(m_command_resources.data() + cmd.render_targets.offset),
+						static_cast<ID3D11DepthStencilView*>(cmd.render_targets.depth_stencil)
 					);
 
 					m_profiler->m_rhi_bindings_render_target++;
@@ -508,8 +340,8 @@ namespace Spartan
 				{
 					device_context->ClearRenderTargetView
 					(
-						static_cast<ID3D11RenderTargetView*>(cmd.render_target_clear),
-						cmd.render_target_clear_color.Data()
+						static_cast<ID3D11RenderTargetView*>(cmd.clear_render_target.render_target),
+						cmd.clear_render_target.color
 					);
 					break;
 				}
@@ -517,17 +349,32 @@ namespace Spartan
 				case RHI_Cmd_ClearDepthStencil:
 				{
 					UINT clear_flags = 0;
-					clear_flags |= (cmd.depth_clear_flags & Clear_Depth)	? D3D11_CLEAR_DEPTH : 0;
-					clear_flags |= (cmd.depth_clear_flags & Clear_Stencil)	? D3D11_CLEAR_STENCIL : 0;
+					clear_flags |= (cmd.clear_depth_stencil.flags & Clear_Depth)	? D3D11_CLEAR_DEPTH : 0;
+					clear_flags |= (cmd.clear_depth_stencil.flags & Clear_Stencil)	? D3D11_CLEAR_STENCIL : 0;
 
 					device_context->ClearDepthStencilView
 					(
-						static_cast<ID3D11DepthStencilView*>(cmd.depth_stencil),
+						static_cast<ID3D11DepthStencilView*>(cmd.clear_depth_stencil.depth_stencil),
 						clear_flags,
-						static_cast<FLOAT>(cmd.depth_clear),
-						static_cast<UINT8>(cmd.depth_clear_stencil)
+						static_cast<FLOAT>(cmd.clear_depth_stencil.depth),
+						static_cast<UINT8>(cmd.clear_depth_stencil.stencil)
 					);
+					break;
+				}
+
+				case RHI_Cmd_CopyTexture:
+				{
+					// The textures are only referenced through their views
+					ID3D11Resource* source		= nullptr;
+					ID3D11Resource* destination	= nullptr;
+					static_cast<ID3D11ShaderResourceView*>(cmd.copy.source)->GetResource(&source);
+					static_cast<ID3D11ShaderResourceView*>(cmd.copy.destination)->GetResource(&destination);
+
+					const auto subresource = D3D11CalcSubresource(0, static_cast<UINT>(cmd.copy.array_index), 1);
+					device_context->CopySubresourceRegion(destination, subresource, 0, 0, 0, source, subresource, nullptr);
 
+					safe_release(source);
+					safe_release(destination);
 					break;
 				}
 			}
@@ -536,32 +383,6 @@ namespace Spartan
 		Clear();
 		return true;
 	}
-
-	RHI_Command& RHI_CommandList::GetCmd()
-	{
-		// Grow capacity if needed
-		if (m_command_count >= m_commands.size())
-		{
-			const auto new_size = m_command_count + 100;
-			m_commands.reserve(new_size);
-			m_commands.resize(new_size);
-			LOGF_WARNING("Command list has grown to fit %d commands. Consider making the capacity larger to avoid re-allocations.", m_command_count + 1);
-		}
-
-		m_command_count++;
-		return m_commands[m_command_count - 1];	
-	}
-
-	void RHI_CommandList::Clear()
-	{
-		for (uint32_t cmd_index = 0; cmd_index < m_command_count; cmd_index++)
-		{
-			auto& cmd = m_commands[cmd_index];
-			cmd.Clear();
-		}
-
-		m_command_count = 0;
-	}
 }
 
 #endif
\ No newline at end of file
@@ -166,11 +166,25 @@ namespace Spartan
 			return;
 		}
 
+		// Constant buffer ranges (D3D11.1), the command list sub-allocates per draw constants from a single buffer
+		D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+		if (SUCCEEDED(m_rhi_context->device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) &&
+			options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer)
+		{
+			m_rhi_context->device_context->QueryInterface(IID_PPV_ARGS(&m_rhi_context->device_context_1));
+		}
+
+		if (!m_rhi_context->device_context_1)
+		{
+			LOG_WARNING("Constant buffer offsetting is not supported, per draw constants will be uploaded one at a time");
+		}
+
 		m_initialized = true;
 	}
 
 	RHI_Device::~RHI_Device()
 	{
+		safe_release(m_rhi_context->device_context_1);
 		safe_release(m_rhi_context->device_context);
 		safe_release(m_rhi_context->device);
 		safe_release(m_rhi_context->annotation);
@@ -0,0 +1,130 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ========================
+#include "../../Profiling/Profiler.h"
+#include "../RHI_CommandList.h"
+#include "../RHI_Device.h"
+//===================================
+
+namespace Spartan
+{
+	bool RHI_CommandList::Submit()
+	{
+		// The constants still go through the ring buffer, so that filling it is part of what's measured
+		ConstantsUpload();
+
+		// Nothing executes, but the profiler sees the same draw calls and bindings as it would with a GPU
+		for (const auto& cmd : m_commands)
+		{
+			switch (cmd.type)
+			{
+				case RHI_Cmd_Begin:
+				{
+					m_profiler->TimeBlockStart(*cmd.pass.name, true, true);
+					break;
+				}
+
+				case RHI_Cmd_End:
+				{
+					m_profiler->TimeBlockEnd();
+					break;
+				}
+
+				case RHI_Cmd_Draw:
+				case RHI_Cmd_DrawIndexed:
+				case RHI_Cmd_DrawIndexedInstanced:
+				{
+					m_profiler->m_rhi_draw_calls++;
+					break;
+				}
+
+				case RHI_Cmd_SetVertexBuffer:
+				{
+					m_profiler->m_rhi_bindings_buffer_vertex++;
+					break;
+				}
+
+				case RHI_Cmd_SetIndexBuffer:
+				{
+					m_profiler->m_rhi_bindings_buffer_index++;
+					break;
+				}
+
+				case RHI_Cmd_SetVertexShader:
+				{
+					m_profiler->m_rhi_bindings_vertex_shader++;
+					break;
+				}
+
+				case RHI_Cmd_SetPixelShader:
+				{
+					m_profiler->m_rhi_bindings_pixel_shader++;
+					break;
+				}
+
+				case RHI_Cmd_SetConstantBuffers:
+				{
+					m_profiler->m_rhi_bindings_buffer_constant += (cmd.resources.scope == Buffer_Global) ? 2 : 1;
+					break;
+				}
+
+				case RHI_Cmd_SetConstantBufferData:
+				{
+					m_profiler->m_rhi_bindings_buffer_constant += (cmd.constants.scope == Buffer_Global) ? 2 : 1;
+					break;
+				}
+
+				case RHI_Cmd_SetSamplers:
+				{
+					m_profiler->m_rhi_bindings_sampler++;
+					break;
+				}
+
+				case RHI_Cmd_SetTextures:
+				{
+					m_profiler->m_rhi_bindings_texture++;
+					break;
+				}
+
+				case RHI_Cmd_SetRenderTargets:
+				{
+					m_profiler->m_rhi_bindings_render_target++;
+					break;
+				}
+
+				default:
+					break;
+			}
+		}
+
+		m_rhi_device->GetContext()->commands_executed += m_commands.size();
+
+		Clear();
+		return true;
+	}
+}
+#endif
@@ -0,0 +1,92 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES =====================
+#include "../RHI_ConstantBuffer.h"
+#include "../RHI_Device.h"
+#include "../../Logging/Log.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RHI_ConstantBuffer::~RHI_ConstantBuffer()
+	{
+		if (m_buffer_memory)
+		{
+			m_rhi_device->GetContext()->memory_allocated -= m_size;
+		}
+
+		delete[] static_cast<uint8_t*>(m_buffer_memory);
+		m_buffer_memory	= nullptr;
+		m_buffer		= nullptr;
+	}
+
+	void* RHI_ConstantBuffer::Map(const bool discard /*= true*/) const
+	{
+		if (!m_rhi_device || !m_buffer_memory)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return nullptr;
+		}
+
+		// Host memory is never in use by a GPU, so it's the same whether it's discarded or not
+		m_rhi_device->GetContext()->maps++;
+		return m_buffer_memory;
+	}
+
+	bool RHI_ConstantBuffer::Unmap() const
+	{
+		if (!m_rhi_device || !m_buffer_memory)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool RHI_ConstantBuffer::_Create()
+	{
+		if (!m_rhi_device || m_size == 0)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		// The memory doubles as the resource, so that it's unique and can be bound
+		m_buffer_memory	= new uint8_t[m_size]();
+		m_buffer		= m_buffer_memory;
+		m_rhi_device->GetContext()->objects_created++;
+		m_rhi_device->GetContext()->memory_allocated += m_size;
+
+		return true;
+	}
+}
+#endif
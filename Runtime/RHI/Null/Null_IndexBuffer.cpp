@@ -0,0 +1,111 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ==================
+#include <cstring>
+#include "../RHI_IndexBuffer.h"
+#include "../RHI_Device.h"
+#include "../../Logging/Log.h"
+//=============================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RHI_IndexBuffer::~RHI_IndexBuffer()
+	{
+		if (m_buffer_memory)
+		{
+			m_rhi_device->GetContext()->memory_allocated -= m_size;
+		}
+
+		delete[] static_cast<uint8_t*>(m_buffer_memory);
+		m_buffer_memory	= nullptr;
+		m_buffer		= nullptr;
+	}
+
+	bool RHI_IndexBuffer::Create(const void* indices)
+	{
+		if (!m_rhi_device)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		if (!m_is_dynamic)
+		{
+			if (!indices || m_index_count == 0)
+			{
+				LOG_ERROR_INVALID_PARAMETER();
+				return false;
+			}
+		}
+
+		if (m_buffer_memory)
+		{
+			m_rhi_device->GetContext()->memory_allocated -= m_size;
+			delete[] static_cast<uint8_t*>(m_buffer_memory);
+		}
+
+		// The memory doubles as the resource, so that it's unique and can be bound
+		m_buffer_memory	= new uint8_t[m_size]();
+		m_buffer		= m_buffer_memory;
+		if (indices)
+		{
+			memcpy(m_buffer_memory, indices, m_size);
+		}
+		m_rhi_device->GetContext()->objects_created++;
+		m_rhi_device->GetContext()->memory_allocated += m_size;
+
+		return true;
+	}
+
+	void* RHI_IndexBuffer::Map() const
+	{
+		if (!m_rhi_device || !m_buffer_memory)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return nullptr;
+		}
+
+		m_rhi_device->GetContext()->maps++;
+		return m_buffer_memory;
+	}
+
+	bool RHI_IndexBuffer::Unmap() const
+	{
+		if (!m_rhi_device || !m_buffer_memory)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return false;
+		}
+
+		return true;
+	}
+}
+#endif
@@ -0,0 +1,78 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#include "../RHI_Vertex.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES ===========================
+#include "../RHI_Device.h"
+#include "../RHI_Shader.h"
+#include "../RHI_InputLayout.h"
+#include "../../Logging/Log.h"
+#include "../../FileSystem/FileSystem.h"
+//======================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RHI_Shader::~RHI_Shader()
+	{
+		m_vertex_shader	= nullptr;
+		m_pixel_shader	= nullptr;
+	}
+
+	template <typename T>
+	void* RHI_Shader::_Compile(const Shader_Type type, const string& shader)
+	{
+		if (!m_rhi_device)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return nullptr;
+		}
+
+		// Nothing is compiled, but a missing file still fails like it would with a real compiler
+		if (FileSystem::IsSupportedShaderFile(shader) && !FileSystem::FileExists(shader))
+		{
+			LOGF_ERROR("Failed to find shader \"%s\" with path \"%s\".", FileSystem::GetFileNameFromFilePath(shader).c_str(), shader.c_str());
+			return nullptr;
+		}
+
+		void* shader_view = Null_Common::handle_create(m_rhi_device->GetContext());
+
+		// Create input layout, there is no bytecode so anything which isn't null will do as the blob
+		if (type == Shader_Vertex && RHI_Vertex_Type_To_Enum<T>() != RHI_Vertex_Type_Unknown)
+		{
+			if (!m_input_layout->Create<T>(shader_view))
+			{
+				LOGF_ERROR("Failed to create input layout for %s", FileSystem::GetFileNameFromFilePath(m_file_path).c_str());
+			}
+		}
+
+		return shader_view;
+	}
+}
+#endif
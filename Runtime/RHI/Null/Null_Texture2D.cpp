@@ -0,0 +1,81 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION ===============
+#include "../RHI_Implementation.h"
+#ifdef API_GRAPHICS_NULL
+//================================
+
+//= INCLUDES =====================
+#include "../RHI_Texture2D.h"
+#include "../RHI_Device.h"
+#include "../../Logging/Log.h"
+//================================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	RHI_Texture2D::~RHI_Texture2D()
+	{
+		m_resource_texture			= nullptr;
+		m_resource_render_target	= nullptr;
+		m_resource_depth_stencils.clear();
+	}
+
+	bool RHI_Texture2D::CreateResourceGpu()
+	{
+		if (!m_rhi_device)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		// Regular texture: needs data to be initialized from
+		if (!m_is_render_texture && m_data.empty())
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return false;
+		}
+
+		const auto context		= m_rhi_device->GetContext();
+		m_resource_texture		= Null_Common::handle_create(context);
+
+		// Depth stencil textures get a view per array slice, like they do with the other APIs
+		if (m_is_render_texture && m_format == Format_D32_FLOAT)
+		{
+			m_resource_depth_stencils.clear();
+			for (uint32_t i = 0; i < m_array_size; i++)
+			{
+				m_resource_depth_stencils.emplace_back(Null_Common::handle_create(context));
+			}
+		}
+		else if (m_is_render_texture)
+		{
+			m_resource_render_target = Null_Common::handle_create(context);
+		}
+
+		return true;
+	}
+}
+#endif
@@ -0,0 +1,513 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= IMPLEMENTATION =======================================================
+#include "RHI_Implementation.h"
+// Vulkan records straight into its command buffers, the rest record here
+#if defined(API_GRAPHICS_D3D11) || defined(API_GRAPHICS_NULL)
+//========================================================================
+
+//= INCLUDES ===================
+#include "RHI_CommandList.h"
+#include <cstring>
+#include "RHI_Pipeline.h"
+#include "RHI_Sampler.h"
+#include "RHI_Texture.h"
+#include "RHI_Shader.h"
+#include "RHI_ConstantBuffer.h"
+#include "RHI_VertexBuffer.h"
+#include "RHI_IndexBuffer.h"
+#include "RHI_BlendState.h"
+#include "RHI_DepthStencilState.h"
+#include "RHI_RasterizerState.h"
+#include "RHI_InputLayout.h"
+#include "../Logging/Log.h"
+#include "../Math/MathHelper.h"
+//==============================
+
+//= NAMESPACES ===============
+using namespace std;
+using namespace Spartan::Math;
+using namespace Helper;
+//============================
+
+namespace Spartan
+{
+	RHI_CommandList::RHI_CommandList(const shared_ptr<RHI_Device>& rhi_device, Profiler* profiler)
+	{
+		m_commands.reserve(1024);
+		m_command_resources.reserve(1024);
+		m_rhi_device	= rhi_device;
+		m_profiler		= profiler;
+		Clear();
+	}
+
+	RHI_CommandList::~RHI_CommandList() = default;
+
+	void RHI_CommandList::Begin(const string& pass_name, void* render_pass, RHI_SwapChain* swap_chain)
+	{
+		auto& cmd		= GetCmd();
+		cmd.type		= RHI_Cmd_Begin;
+		cmd.pass.name	= &*m_pass_names.emplace(pass_name).first;
+	}
+
+	void RHI_CommandList::End()
+	{
+		auto& cmd	= GetCmd();
+		cmd.type	= RHI_Cmd_End;
+	}
+
+	void RHI_CommandList::Draw(const uint32_t vertex_count)
+	{
+		auto& cmd				= GetCmd();
+		cmd.type				= RHI_Cmd_Draw;
+		cmd.draw.vertex_count	= vertex_count;
+	}
+
+	void RHI_CommandList::DrawIndexed(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset)
+	{
+		auto& cmd				= GetCmd();
+		cmd.type				= RHI_Cmd_DrawIndexed;
+		cmd.draw.index_count	= index_count;
+		cmd.draw.index_offset	= index_offset;
+		cmd.draw.vertex_offset	= vertex_offset;
+	}
+
+	void RHI_CommandList::DrawIndexedInstanced(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset, const uint32_t instance_count, const uint32_t instance_offset /*= 0*/)
+	{
+		auto& cmd					= GetCmd();
+		cmd.type					= RHI_Cmd_DrawIndexedInstanced;
+		cmd.draw.index_count		= index_count;
+		cmd.draw.index_offset		= index_offset;
+		cmd.draw.vertex_offset		= vertex_offset;
+		cmd.draw.instance_count		= instance_count;
+		cmd.draw.instance_offset	= instance_offset;
+	}
+
+	void RHI_CommandList::SetPipeline(RHI_Pipeline* pipeline)
+	{
+		SetViewport(pipeline->GetState()->viewport);
+		SetBlendState(pipeline->GetState()->blend_state);
+		SetDepthStencilState(pipeline->GetState()->depth_stencil_state);
+		SetRasterizerState(pipeline->GetState()->rasterizer_state);
+		SetInputLayout(pipeline->GetState()->shader_vertex->GetInputLayout());
+		SetShaderVertex(pipeline->GetState()->shader_vertex);
+		SetShaderPixel(pipeline->GetState()->shader_pixel);
+		SetPrimitiveTopology(pipeline->GetState()->primitive_topology);
+	}
+
+	void RHI_CommandList::SetViewport(const RHI_Viewport& viewport)
+	{
+		if (viewport == m_viewport_recorded)
+			return;
+		m_viewport_recorded = viewport;
+
+		auto& cmd					= GetCmd();
+		cmd.type					= RHI_Cmd_SetViewport;
+		cmd.viewport.x				= viewport.GetX();
+		cmd.viewport.y				= viewport.GetY();
+		cmd.viewport.width			= viewport.GetWidth();
+		cmd.viewport.height			= viewport.GetHeight();
+		cmd.viewport.depth_min		= viewport.GetMinDepth();
+		cmd.viewport.depth_max		= viewport.GetMaxDepth();
+	}
+
+	void RHI_CommandList::SetScissorRectangle(const Math::Rectangle& scissor_rectangle)
+	{
+		auto& cmd				= GetCmd();
+		cmd.type				= RHI_Cmd_SetScissorRectangle;
+		cmd.rectangle.x			= scissor_rectangle.x;
+		cmd.rectangle.y			= scissor_rectangle.y;
+		cmd.rectangle.width		= scissor_rectangle.width;
+		cmd.rectangle.height	= scissor_rectangle.height;
+	}
+
+	void RHI_CommandList::SetPrimitiveTopology(const RHI_PrimitiveTopology_Mode primitive_topology)
+	{
+		if (!StateChange(State_PrimitiveTopology, reinterpret_cast<const void*>(static_cast<uintptr_t>(primitive_topology))))
+			return;
+
+		auto& cmd			= GetCmd();
+		cmd.type			= RHI_Cmd_SetPrimitiveTopology;
+		cmd.topology.mode	= primitive_topology;
+	}
+
+	void RHI_CommandList::SetInputLayout(const RHI_InputLayout* input_layout)
+	{
+		const auto resource = input_layout->GetResource();
+		if (!StateChange(State_InputLayout, resource))
+			return;
+
+		auto& cmd			= GetCmd();
+		cmd.type			= RHI_Cmd_SetInputLayout;
+		cmd.state.resource	= resource;
+	}
+
+	void RHI_CommandList::SetDepthStencilState(const RHI_DepthStencilState* depth_stencil_state)
+	{
+		const auto resource = depth_stencil_state->GetBuffer();
+		if (!StateChange(State_DepthStencil, resource))
+			return;
+
+		auto& cmd			= GetCmd();
+		cmd.type			= RHI_Cmd_SetDepthStencilState;
+		cmd.state.resource	= resource;
+	}
+
+	void RHI_CommandList::SetRasterizerState(const RHI_RasterizerState* rasterizer_state)
+	{
+		const auto resource = rasterizer_state->GetBuffer();
+		if (!StateChange(State_Rasterizer, resource))
+			return;
+
+		auto& cmd			= GetCmd();
+		cmd.type			= RHI_Cmd_SetRasterizerState;
+		cmd.state.resource	= resource;
+	}
+
+	void RHI_CommandList::SetBlendState(const RHI_BlendState* blend_state)
+	{
+		const auto resource = blend_state->GetBuffer();
+		if (!StateChange(State_Blend, resource))
+			return;
+
+		auto& cmd			= GetCmd();
+		cmd.type			= RHI_Cmd_SetBlendState;
+		cmd.state.resource	= resource;
+	}
+
+	void RHI_CommandList::SetBufferVertex(const RHI_VertexBuffer* buffer, const uint32_t slot /*= 0*/)
+	{
+		const auto resource = buffer->GetResource();
+		if (slot <= 1 && !StateChange(slot == 0 ? State_BufferVertex : State_BufferInstance, resource))
+			return;
+
+		auto& cmd			= GetCmd();
+		cmd.type			= RHI_Cmd_SetVertexBuffer;
+		cmd.buffer.resource	= resource;
+		cmd.buffer.slot		= slot;
+		cmd.buffer.stride	= buffer->GetStride();
+	}
+
+	void RHI_CommandList::SetBufferIndex(const RHI_IndexBuffer* buffer)
+	{
+		const auto resource = buffer->GetResource();
+		if (!StateChange(State_BufferIndex, resource))
+			return;
+
+		auto& cmd			= GetCmd();
+		cmd.type			= RHI_Cmd_SetIndexBuffer;
+		cmd.buffer.resource	= resource;
+		cmd.buffer.stride	= buffer->Is16Bit() ? 2 : 4;
+	}
+
+	void RHI_CommandList::SetShaderVertex(const RHI_Shader* shader)
+	{
+		const auto resource = shader->GetResource_VertexShader();
+		if (!StateChange(State_ShaderVertex, resource))
+			return;
+
+		auto& cmd			= GetCmd();
+		cmd.type			= RHI_Cmd_SetVertexShader;
+		cmd.state.resource	= resource;
+	}
+
+	void RHI_CommandList::SetShaderPixel(const RHI_Shader* shader)
+	{
+		const auto resource = shader ? shader->GetResource_PixelShader() : nullptr;
+		if (!StateChange(State_ShaderPixel, resource))
+			return;
+
+		auto& cmd			= GetCmd();
+		cmd.type			= RHI_Cmd_SetPixelShader;
+		cmd.state.resource	= resource;
+	}
+
+	void RHI_CommandList::SetConstantBuffers(const uint32_t start_slot, const RHI_Buffer_Scope scope, const vector<void*>& constant_buffers)
+	{
+		auto& cmd					= GetCmd();
+		cmd.type					= RHI_Cmd_SetConstantBuffers;
+		cmd.resources.start_slot	= start_slot;
+		cmd.resources.scope			= scope;
+		cmd.resources.count			= static_cast<uint32_t>(constant_buffers.size());
+		cmd.resources.offset		= AddResources(constant_buffers.data(), cmd.resources.count);
+	}
+
+	void RHI_CommandList::SetConstantBuffer(const uint32_t start_slot, const RHI_Buffer_Scope scope, const shared_ptr<RHI_ConstantBuffer>& constant_buffer)
+	{
+		const auto resource = constant_buffer->GetResource();
+
+		auto& cmd					= GetCmd();
+		cmd.type					= RHI_Cmd_SetConstantBuffers;
+		cmd.resources.start_slot	= start_slot;
+		cmd.resources.scope			= scope;
+		cmd.resources.count			= 1;
+		cmd.resources.offset		= AddResources(&resource, 1);
+	}
+
+	void RHI_CommandList::SetConstantBufferData(const uint32_t slot, const RHI_Buffer_Scope scope, const void* data, const uint32_t size)
+	{
+		// A constant buffer can't be larger than 4096 constants
+		const uint32_t size_max = 4096 * 16;
+		if (!data || size == 0 || size > size_max)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		// Constant buffer offsets are in multiples of 16 constants
+		const uint32_t alignment	= 256;
+		const auto offset			= static_cast<uint32_t>(m_constants.size());
+		const auto size_aligned		= (size + alignment - 1) & ~(alignment - 1);
+		m_constants.resize(offset + size_aligned);
+		memcpy(m_constants.data() + offset, data, size);
+
+		auto& cmd				= GetCmd();
+		cmd.type				= RHI_Cmd_SetConstantBufferData;
+		cmd.constants.slot		= slot;
+		cmd.constants.scope		= scope;
+		cmd.constants.offset	= offset;
+		cmd.constants.size		= size_aligned;
+	}
+
+	void RHI_CommandList::SetSamplers(const uint32_t start_slot, const vector<void*>& samplers)
+	{
+		auto& cmd					= GetCmd();
+		cmd.type					= RHI_Cmd_SetSamplers;
+		cmd.resources.start_slot	= start_slot;
+		cmd.resources.count			= static_cast<uint32_t>(samplers.size());
+		cmd.resources.offset		= AddResources(samplers.data(), cmd.resources.count);
+	}
+
+	void RHI_CommandList::SetSampler(const uint32_t start_slot, const shared_ptr<RHI_Sampler>& sampler)
+	{
+		const auto resource = sampler->GetResource();
+
+		auto& cmd					= GetCmd();
+		cmd.type					= RHI_Cmd_SetSamplers;
+		cmd.resources.start_slot	= start_slot;
+		cmd.resources.count			= 1;
+		cmd.resources.offset		= AddResources(&resource, 1);
+	}
+
+	void RHI_CommandList::SetTextures(const uint32_t start_slot, const vector<void*>& textures)
+	{
+		auto& cmd					= GetCmd();
+		cmd.type					= RHI_Cmd_SetTextures;
+		cmd.resources.start_slot	= start_slot;
+		cmd.resources.count			= static_cast<uint32_t>(textures.size());
+		cmd.resources.offset		= AddResources(textures.data(), cmd.resources.count);
+	}
+
+	void RHI_CommandList::SetTexture(const uint32_t start_slot, RHI_Texture* texture)
+	{
+		const auto resource = texture ? texture->GetResource_Texture() : nullptr;
+
+		auto& cmd					= GetCmd();
+		cmd.type					= RHI_Cmd_SetTextures;
+		cmd.resources.start_slot	= start_slot;
+		cmd.resources.count			= 1;
+		cmd.resources.offset		= AddResources(&resource, 1);
+	}
+
+	void RHI_CommandList::SetRenderTargets(const vector<void*>& render_targets, void* depth_stencil /*= nullptr*/)
+	{
+		auto& cmd							= GetCmd();
+		cmd.type							= RHI_Cmd_SetRenderTargets;
+		cmd.render_targets.count			= static_cast<uint32_t>(render_targets.size());
+		cmd.render_targets.offset			= AddResources(render_targets.data(), cmd.render_targets.count);
+		cmd.render_targets.depth_stencil	= depth_stencil;
+	}
+
+	void RHI_CommandList::SetRenderTarget(void* render_target, void* depth_stencil /*= nullptr*/)
+	{
+		auto& cmd							= GetCmd();
+		cmd.type							= RHI_Cmd_SetRenderTargets;
+		cmd.render_targets.count			= 1;
+		cmd.render_targets.offset			= AddResources(&render_target, 1);
+		cmd.render_targets.depth_stencil	= depth_stencil;
+	}
+
+	void RHI_CommandList::SetRenderTarget(const shared_ptr<RHI_Texture>& render_target, void* depth_stencil /*= nullptr*/)
+	{
+		SetRenderTarget(render_target->GetResource_RenderTarget(), depth_stencil);
+	}
+
+	void RHI_CommandList::ClearRenderTarget(void* render_target, const Vector4& color)
+	{
+		auto& cmd								= GetCmd();
+		cmd.type								= RHI_Cmd_ClearRenderTarget;
+		cmd.clear_render_target.render_target	= render_target;
+		memcpy(cmd.clear_render_target.color, color.Data(), sizeof(cmd.clear_render_target.color));
+	}
+
+	void RHI_CommandList::ClearDepthStencil(void* depth_stencil, const uint32_t flags, const float depth, const uint32_t stencil /*= 0*/)
+	{
+		if (!depth_stencil)
+		{
+			LOG_ERROR("Provided depth stencil is null");
+			return;
+		}
+
+		auto& cmd								= GetCmd();
+		cmd.type								= RHI_Cmd_ClearDepthStencil;
+		cmd.clear_depth_stencil.depth_stencil	= depth_stencil;
+		cmd.clear_depth_stencil.flags			= flags;
+		cmd.clear_depth_stencil.depth			= depth;
+		cmd.clear_depth_stencil.stencil			= stencil;
+	}
+
+	void RHI_CommandList::CopyTexture(RHI_Texture* source, RHI_Texture* destination, const uint32_t array_index /*= 0*/)
+	{
+		if (!source || !destination)
+		{
+			LOG_ERROR_INVALID_PARAMETER();
+			return;
+		}
+
+		auto& cmd				= GetCmd();
+		cmd.type				= RHI_Cmd_CopyTexture;
+		cmd.copy.source			= source->GetResource_Texture();
+		cmd.copy.destination	= destination->GetResource_Texture();
+		cmd.copy.array_index	= array_index;
+	}
+
+	bool RHI_CommandList::IsCopySupported()
+	{
+		return true;
+	}
+
+	void RHI_CommandList::Append(RHI_CommandList& cmd_list)
+	{
+		// The appended commands index into this list's resources and constants
+		const auto resource_offset	= static_cast<uint32_t>(m_command_resources.size());
+		const auto constants_offset	= static_cast<uint32_t>(m_constants.size());
+		m_command_resources.insert(m_command_resources.end(), cmd_list.m_command_resources.begin(), cmd_list.m_command_resources.end());
+		m_constants.insert(m_constants.end(), cmd_list.m_constants.begin(), cmd_list.m_constants.end());
+
+		// Pass names stay valid as they are interned by the other list, which is never destroyed before this one
+		m_commands.reserve(m_commands.size() + cmd_list.m_commands.size());
+		for (auto cmd : cmd_list.m_commands)
+		{
+			if (cmd.type == RHI_Cmd_SetConstantBuffers || cmd.type == RHI_Cmd_SetSamplers || cmd.type == RHI_Cmd_SetTextures)
+			{
+				cmd.resources.offset += resource_offset;
+			}
+			else if (cmd.type == RHI_Cmd_SetRenderTargets)
+			{
+				cmd.render_targets.offset += resource_offset;
+			}
+			else if (cmd.type == RHI_Cmd_SetConstantBufferData)
+			{
+				cmd.constants.offset += constants_offset;
+			}
+
+			m_commands.emplace_back(cmd);
+		}
+
+		// What's bound after the appended commands isn't known to this list
+		StateForget();
+
+		cmd_list.Clear();
+	}
+
+	RHI_Command& RHI_CommandList::GetCmd()
+	{
+		m_commands.emplace_back();
+		return m_commands.back();
+	}
+
+	uint32_t RHI_CommandList::ConstantsUpload()
+	{
+		const auto constants_size = static_cast<uint32_t>(m_constants.size());
+		if (constants_size == 0)
+			return 0;
+
+		// The constants go after the constants of the previous submissions, which the GPU may still be reading,
+		// and when they don't fit the ring buffer is discarded and filled from the start
+		auto discard = false;
+		if (!m_constants_ring || m_constants_ring->GetSize() < constants_size)
+		{
+			const uint32_t size_min	= 1024 * 1024;
+			m_constants_ring		= make_shared<RHI_ConstantBuffer>(m_rhi_device);
+			m_constants_ring_offset	= 0;
+			discard					= true;
+			if (!m_constants_ring->Create(Max(constants_size * 2, size_min)))
+			{
+				LOG_ERROR("Failed to create constant ring buffer");
+				m_constants_ring = nullptr;
+				return 0;
+			}
+		}
+		else if (m_constants_ring_offset + constants_size > m_constants_ring->GetSize())
+		{
+			m_constants_ring_offset	= 0;
+			discard					= true;
+		}
+
+		if (const auto data = static_cast<uint8_t*>(m_constants_ring->Map(discard)))
+		{
+			memcpy(data + m_constants_ring_offset, m_constants.data(), constants_size);
+			m_constants_ring->Unmap();
+		}
+
+		const auto constants_base	= m_constants_ring_offset;
+		m_constants_ring_offset		+= constants_size;
+		return constants_base;
+	}
+
+	bool RHI_CommandList::StateChange(const RHI_State_Type type, const void* value)
+	{
+		if (m_states_recorded[type] == value)
+			return false;
+
+		m_states_recorded[type] = value;
+		return true;
+	}
+
+	void RHI_CommandList::StateForget()
+	{
+		// The command list's own address is never a bound resource
+		m_states_recorded.fill(this);
+		m_viewport_recorded = RHI_Viewport(0.0f, 0.0f, -1.0f, -1.0f);
+	}
+
+	uint32_t RHI_CommandList::AddResources(void* const* resources, const uint32_t count)
+	{
+		const auto offset = static_cast<uint32_t>(m_command_resources.size());
+		m_command_resources.insert(m_command_resources.end(), resources, resources + count);
+		return offset;
+	}
+
+	void RHI_CommandList::Clear()
+	{
+		// The memory is kept for the next recording
+		m_commands.clear();
+		m_command_resources.clear();
+		m_constants.clear();
+
+		// Bindings which happen outside of the command list (e.g. by the editor) aren't tracked,
+		// so every submission starts without any knowledge of what's bound
+		StateForget();
+	}
+}
+
+#endif
\ No newline at end of file
@@ -22,7 +22,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES =================
+#include <array>
 #include <vector>
+#include <unordered_set>
 #include "RHI_Definition.h"
 #include "RHI_Viewport.h"
 #include "../Math/Rectangle.h"
@@ -39,6 +41,7 @@ namespace Spartan
 		RHI_Cmd_End,
 		RHI_Cmd_Draw,
 		RHI_Cmd_DrawIndexed,
+		RHI_Cmd_DrawIndexedInstanced,
 		RHI_Cmd_SetViewport,
 		RHI_Cmd_SetScissorRectangle,
 		RHI_Cmd_SetPrimitiveTopology,
@@ -51,106 +54,36 @@ namespace Spartan
 		RHI_Cmd_SetVertexShader,
 		RHI_Cmd_SetPixelShader,
 		RHI_Cmd_SetConstantBuffers,
+		RHI_Cmd_SetConstantBufferData,
 		RHI_Cmd_SetSamplers,
 		RHI_Cmd_SetTextures,
 		RHI_Cmd_SetRenderTargets,
 		RHI_Cmd_ClearRenderTarget,
-		RHI_Cmd_ClearDepthStencil
+		RHI_Cmd_ClearDepthStencil,
+		RHI_Cmd_CopyTexture
 	};
 
+	// A command is plain data which is recorded and later executed by Submit(). Commands which bind a variable number of
+	// resources (constant buffers, samplers, textures, render targets) keep them in the command list's resource arena.
 	struct RHI_Command
 	{
-		RHI_Command()
-		{
-			const uint32_t max_count = 10;
-			render_targets.reserve(max_count);
-			render_targets.resize(max_count);
-			textures.reserve(max_count);
-			textures.resize(max_count);
-			samplers.reserve(max_count);
-			samplers.resize(max_count);
-			constant_buffers.reserve(max_count);
-			constant_buffers.resize(max_count);
-			Clear();
-		}
-
-		void Clear()
-		{
-			render_target_count			= 0;
-			textures_start_slot			= 0;
-			texture_count				= 0;
-			samplers_start_slot			= 0;
-			sampler_count				= 0;
-			constant_buffers_start_slot	= 0;
-			constant_buffer_count		= 0;
-			constant_buffers_scope		= Buffer_NotAssigned;
-			depth_stencil_state			= nullptr;
-			depth_stencil				= nullptr;
-			depth_clear					= 0;
-			depth_clear_stencil			= 0;
-			depth_clear_flags			= 
-			vertex_count				= 0;
-			vertex_offset				= 0;
-			index_count					= 0;
-			index_offset				= 0;
-			input_layout				= nullptr;
-			rasterizer_state			= nullptr;
-			blend_state					= nullptr;
-			buffer_index				= nullptr;
-			buffer_vertex				= nullptr;
-			shader_vertex				= nullptr;
-			shader_pixel				= nullptr;
-			pass_name					= "N/A";
-			primitive_topology			= PrimitiveTopology_NotAssigned;
-		}
-
 		RHI_Cmd_Type type;
-
-		// Render targets
-		uint32_t render_target_count = 0;
-		std::vector<void*> render_targets;
-		void* render_target_clear;
-		Math::Vector4 render_target_clear_color;
-
-		// Texture
-		uint32_t textures_start_slot = 0;
-		uint32_t texture_count = 0;
-		std::vector<void*> textures;
-
-		// Samplers
-		uint32_t samplers_start_slot = 0;
-		uint32_t sampler_count = 0;
-		std::vector<void*> samplers;
-
-		// Constant buffers
-		uint32_t constant_buffers_start_slot = 0;
-		uint32_t constant_buffer_count = 0;
-		RHI_Buffer_Scope constant_buffers_scope;
-		std::vector<void*> constant_buffers;	
-
-		// Depth
-		const RHI_DepthStencilState* depth_stencil_state	= nullptr;
-		void* depth_stencil									= nullptr;
-		float depth_clear									= 0;
-		uint32_t depth_clear_stencil						= 0;
-		uint32_t depth_clear_flags							= 0;
-
-		// Misc	
-		std::string pass_name							= "N/A";
-		RHI_PrimitiveTopology_Mode primitive_topology	= PrimitiveTopology_NotAssigned;
-		uint32_t vertex_count							= 0;
-		uint32_t vertex_offset							= 0;
-		uint32_t index_count							= 0;
-		uint32_t index_offset							= 0;		
-		const RHI_InputLayout* input_layout				= nullptr;	
-		const RHI_RasterizerState* rasterizer_state		= nullptr;
-		const RHI_BlendState* blend_state				= nullptr;
-		const RHI_IndexBuffer* buffer_index				= nullptr;
-		const RHI_VertexBuffer* buffer_vertex			= nullptr;
-		const RHI_Shader* shader_vertex					= nullptr;
-		const RHI_Shader* shader_pixel					= nullptr;
-		RHI_Viewport viewport;
-		Math::Rectangle scissor_rectangle;
+		union
+		{
+			struct { const std::string* name; } pass;
+			struct { uint32_t vertex_count, index_count, index_offset, vertex_offset, instance_count, instance_offset; } draw;
+			struct { float x, y, width, height, depth_min, depth_max; } viewport;
+			struct { float x, y, width, height; } rectangle;
+			struct { RHI_PrimitiveTopology_Mode mode; } topology;
+			struct { void* resource; } state; // input layout, depth stencil, rasterizer and blend states, shaders
+			struct { void* resource; uint32_t slot; uint32_t stride; } buffer; // the stride of an index buffer is 2 or 4 bytes
+			struct { uint32_t start_slot, count, offset; RHI_Buffer_Scope scope; } resources;
+			struct { uint32_t slot, offset, size; RHI_Buffer_Scope scope; } constants; // offset into the command list's constants, see SetConstantBufferData()
+			struct { uint32_t count, offset; void* depth_stencil; } render_targets;
+			struct { void* render_target; float color[4]; } clear_render_target;
+			struct { void* depth_stencil; uint32_t flags; float depth; uint32_t stencil; } clear_depth_stencil;
+			struct { void* source; void* destination; uint32_t array_index; } copy;
+		};
 	};
 
 	class SPARTAN_CLASS RHI_CommandList
@@ -164,6 +97,8 @@ namespace Spartan
 
 		void Draw(uint32_t vertex_count);
 		void DrawIndexed(uint32_t index_count, uint32_t index_offset, uint32_t vertex_offset);
+		// Per instance data is read from the vertex buffer bound to slot 1, starting at instance_offset
+		void DrawIndexedInstanced(uint32_t index_count, uint32_t index_offset, uint32_t vertex_offset, uint32_t instance_count, uint32_t instance_offset = 0);
 
 		void SetPipeline(RHI_Pipeline* pipeline);
 
@@ -183,8 +118,8 @@ namespace Spartan
 		void SetBlendState(const RHI_BlendState* blend_state);
 		void SetBlendState(const std::shared_ptr<RHI_BlendState>& blend_state) { SetBlendState(blend_state.get()); }
 
-		void SetBufferVertex(const RHI_VertexBuffer* buffer);
-		void SetBufferVertex(const std::shared_ptr<RHI_VertexBuffer>& buffer) { SetBufferVertex(buffer.get()); }
+		void SetBufferVertex(const RHI_VertexBuffer* buffer, uint32_t slot = 0);
+		void SetBufferVertex(const std::shared_ptr<RHI_VertexBuffer>& buffer, const uint32_t slot = 0) { SetBufferVertex(buffer.get(), slot); }
 
 		void SetBufferIndex(const RHI_IndexBuffer* buffer);
 		void SetBufferIndex(const std::shared_ptr<RHI_IndexBuffer>& buffer) { SetBufferIndex(buffer.get()); }
@@ -197,6 +132,10 @@ namespace Spartan
 
 		void SetConstantBuffers(uint32_t start_slot, RHI_Buffer_Scope scope, const std::vector<void*>& constant_buffers);
 		void SetConstantBuffer(uint32_t slot, RHI_Buffer_Scope scope, const std::shared_ptr<RHI_ConstantBuffer>& constant_buffer);
+		// The data is copied into the command list and uploaded, together with the data of every other call, when the command list is submitted
+		void SetConstantBufferData(uint32_t slot, RHI_Buffer_Scope scope, const void* data, uint32_t size);
+		template<typename T>
+		void SetConstantBufferData(const uint32_t slot, const RHI_Buffer_Scope scope, const T& data) { SetConstantBufferData(slot, scope, &data, static_cast<uint32_t>(sizeof(T))); }
 			
 		void SetSamplers(uint32_t start_slot, const std::vector<void*>& samplers);
 		void SetSampler(uint32_t slot, const std::shared_ptr<RHI_Sampler>& sampler);
@@ -220,10 +159,40 @@ namespace Spartan
 		}
 		void ClearDepthStencil(void* depth_stencil, uint32_t flags, float depth, uint32_t stencil = 0);
 
+		// Copies one array slice between two textures of the same size and format
+		void CopyTexture(RHI_Texture* source, RHI_Texture* destination, uint32_t array_index = 0);
+		// Whether the backend implements CopyTexture(), callers must not rely on copies otherwise
+		static bool IsCopySupported();
+
+		// Moves the commands of a list which was recorded on another thread to the end of this one. Lists which are recorded
+		// in parallel are appended in a fixed order, so what executes doesn't depend on which thread finished first.
+		void Append(RHI_CommandList& cmd_list);
+
 		bool Submit();
 		const auto& GetSemaphoreRenderFinished() { return !m_semaphores_render_finished.empty() ? m_semaphores_render_finished[m_current_frame] : nullptr; }
 
 	private:
+		// Bindings which are dropped at record time when they don't change what's bound
+		enum RHI_State_Type
+		{
+			State_InputLayout,
+			State_DepthStencil,
+			State_Rasterizer,
+			State_Blend,
+			State_ShaderVertex,
+			State_ShaderPixel,
+			State_PrimitiveTopology,
+			State_BufferIndex,
+			State_BufferVertex,
+			State_BufferInstance,
+			State_Count
+		};
+		// Returns false when the value is already bound
+		bool StateChange(RHI_State_Type type, const void* value);
+		void StateForget();
+		uint32_t AddResources(void* const* resources, uint32_t count);
+		// Copies the constants of this submission to the ring buffer, returns the offset they start at
+		uint32_t ConstantsUpload();
 		void OnCmdListConsumed();
 		void Clear();
 
@@ -232,8 +201,16 @@ namespace Spartan
 		// D3D11
 		RHI_Command& GetCmd();
 		std::vector<RHI_Command> m_commands;
-		uint32_t m_initial_capacity = 2500;
-		uint32_t m_command_count	= 0;
+		std::vector<void*> m_command_resources;
+		std::unordered_set<std::string> m_pass_names; // interned, commands point to them
+		std::array<const void*, State_Count> m_states_recorded;
+		RHI_Viewport m_viewport_recorded;
+		// Constants of SetConstantBufferData(), aligned to 256 bytes (the granularity of constant buffer offsets).
+		// Submit() copies them to the ring buffer with a single map, after the constants of the previous submissions.
+		std::vector<uint8_t> m_constants;
+		std::shared_ptr<RHI_ConstantBuffer> m_constants_ring;
+		std::shared_ptr<RHI_ConstantBuffer> m_constants_fallback; // when the device can't bind constant buffer ranges
+		uint32_t m_constants_ring_offset = 0;
 
 		// Vulkan
 		RHI_Command m_empty_cmd; // for GetCmd()
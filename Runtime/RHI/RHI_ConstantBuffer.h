@@ -46,7 +46,15 @@ namespace Spartan
 			return _Create();
 		}
 
-		void* Map() const;
+		// Buffers which are sub-allocated are sized at runtime
+		bool Create(const uint32_t size)
+		{
+			m_size = size;
+			return _Create();
+		}
+
+		// Without discarding, the caller guarantees that it won't overwrite data which the GPU may still be reading
+		void* Map(bool discard = true) const;
 		bool Unmap() const;
 		auto GetResource() const	{ return m_buffer; }
 		auto GetSize()	const		{ return m_size; }
@@ -140,6 +140,7 @@ namespace Spartan
 	{
 		ID3D11Device* device					= nullptr;
 		ID3D11DeviceContext* device_context		= nullptr;
+		ID3D11DeviceContext1* device_context_1	= nullptr; // only when constant buffer ranges can be bound
 		ID3DUserDefinedAnnotation* annotation	= nullptr;
 	};
 }
@@ -293,4 +294,22 @@ namespace Spartan
 #include "Vulkan/Vulkan_Common.h"
 #endif // VULKAN
 
+// NULL
+#if defined(API_GRAPHICS_NULL)
+#include <atomic>
+
+namespace Spartan
+{
+	// Nothing reaches a GPU, the device only counts what it's asked to do
+	struct RHI_Context
+	{
+		std::atomic<uint64_t> objects_created	= 0;
+		std::atomic<uint64_t> memory_allocated	= 0;
+		std::atomic<uint64_t> maps				= 0;
+		std::atomic<uint64_t> commands_executed	= 0;
+	};
+}
+#include "Null/Null_Common.h"
+#endif // NULL
+
 #endif // RUNTIME
\ No newline at end of file
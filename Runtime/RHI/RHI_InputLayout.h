@@ -33,20 +33,22 @@ namespace Spartan
 {
 	struct VertexAttribute 
 	{
-		VertexAttribute(const std::string& name, const uint32_t location, const uint32_t binding, const RHI_Format format, const uint32_t offset)
+		VertexAttribute(const std::string& name, const uint32_t location, const uint32_t binding, const RHI_Format format, const uint32_t offset, const uint32_t semantic_index = 0)
 		{
-			this->name		= name;
-			this->location	= location;
-			this->binding	= binding;
-			this->format	= format;
-			this->offset	= offset;
+			this->name				= name;
+			this->location			= location;
+			this->binding			= binding;
+			this->format			= format;
+			this->offset			= offset;
+			this->semantic_index	= semantic_index;
 		}
 
 		std::string name;
 		uint32_t location;
-		uint32_t binding;
+		uint32_t binding; // 0 is per vertex data, 1 is per instance data
 		RHI_Format format;
 		uint32_t offset;
+		uint32_t semantic_index;
 	};
 
 	class SPARTAN_CLASS RHI_InputLayout
@@ -111,6 +113,31 @@ namespace Spartan
 				};
 			}
 
+			if (RHI_Vertex_Type_To_Enum<T>() == RHI_Vertex_Type_Position_InstanceTransform)
+			{
+				m_vertex_attributes =
+				{
+					{ "POSITION", 0, binding, Format_R32G32B32_FLOAT,	offsetof(RHI_Vertex_Pos, pos) }
+				};
+				AddInstanceMatrix("INSTANCE_WVP", offsetof(RHI_Instance_Transform, wvp));
+				m_instance_stride = sizeof(RHI_Instance_Transform);
+			}
+
+			if (RHI_Vertex_Type_To_Enum<T>() == RHI_Vertex_Type_PositionTextureNormalTangent_InstanceTransformHistory)
+			{
+				m_vertex_attributes =
+				{
+					{ "POSITION",	0, binding, Format_R32G32B32_FLOAT,	offsetof(RHI_Vertex_PosTexNorTan, pos) },
+					{ "TEXCOORD",	1, binding, Format_R32G32_FLOAT,		offsetof(RHI_Vertex_PosTexNorTan, tex) },
+					{ "NORMAL",		2, binding, Format_R32G32B32_FLOAT,	offsetof(RHI_Vertex_PosTexNorTan, nor) },
+					{ "TANGENT",	3, binding, Format_R32G32B32_FLOAT,	offsetof(RHI_Vertex_PosTexNorTan, tan) }
+				};
+				AddInstanceMatrix("INSTANCE_WORLD",			offsetof(RHI_Instance_TransformHistory, world));
+				AddInstanceMatrix("INSTANCE_WVP",			offsetof(RHI_Instance_TransformHistory, wvp_current));
+				AddInstanceMatrix("INSTANCE_WVP_PREVIOUS",	offsetof(RHI_Instance_TransformHistory, wvp_previous));
+				m_instance_stride = sizeof(RHI_Instance_TransformHistory);
+			}
+
 			if (vertex_shader_blob && !m_vertex_attributes.empty())
 			{
 				return _CreateResource(vertex_shader_blob);
@@ -121,11 +148,24 @@ namespace Spartan
 		auto GetVertexType()					const { return m_vertex_type; }
 		const auto& GetAttributeDescriptions()	const { return m_vertex_attributes; }
 		auto GetResource()						const { return m_resource; }
+		auto GetInstanceStride()				const { return m_instance_stride; }
 
 		bool operator==(const RHI_InputLayout& rhs) const { return m_vertex_type == rhs.GetVertexType(); }
 
 	private:
+		// A matrix takes four consecutive attributes, one per 16 bytes, with semantic indices 0 to 3
+		void AddInstanceMatrix(const std::string& name, const uint32_t offset)
+		{
+			const uint32_t binding = 1;
+			for (uint32_t i = 0; i < 4; i++)
+			{
+				const auto location = static_cast<uint32_t>(m_vertex_attributes.size());
+				m_vertex_attributes.emplace_back(name, location, binding, Format_R32G32B32A32_FLOAT, offset + i * 16, i);
+			}
+		}
+
 		RHI_Vertex_Type m_vertex_type;
+		uint32_t m_instance_stride = 0;
 
 		// API
 		bool _CreateResource(void* vertex_shader_blob);
@@ -76,6 +76,8 @@ namespace Spartan
 		static const std::string shader_model		= "5_0";
 		#elif defined(API_GRAPHICS_VULKAN)
 		static const std::string shader_model		= "6_0";
+		#elif defined(API_GRAPHICS_NULL)
+		static const std::string shader_model		= "5_0";
 		#endif
 	}
 
@@ -135,13 +137,15 @@ namespace Spartan
 		void* m_pixel_shader	= nullptr;
 	};
 
-	//= Explicit template instantiation =============================================================================
+	//= Explicit template instantiation ======================================================================================================
 	template void RHI_Shader::CompileAsync<RHI_Vertex_Undefined>(Context*, const Shader_Type, const std::string&);
 	template void RHI_Shader::CompileAsync<RHI_Vertex_Pos>(Context*, const Shader_Type, const std::string&);
 	template void RHI_Shader::CompileAsync<RHI_Vertex_PosTex>(Context*, const Shader_Type, const std::string&);
 	template void RHI_Shader::CompileAsync<RHI_Vertex_PosCol>(Context*, const Shader_Type, const std::string&);
 	template void RHI_Shader::CompileAsync<RHI_Vertex_Pos2dTexCol8>(Context*, const Shader_Type, const std::string&);
 	template void RHI_Shader::CompileAsync<RHI_Vertex_PosTexNorTan>(Context*, const Shader_Type, const std::string&);
+	template void RHI_Shader::CompileAsync<RHI_Vertex_Pos_InstanceTransform>(Context*, const Shader_Type, const std::string&);
+	template void RHI_Shader::CompileAsync<RHI_Vertex_PosTexNorTan_InstanceTransformHistory>(Context*, const Shader_Type, const std::string&);
 
 	template void* RHI_Shader::_Compile<RHI_Vertex_Undefined>(Shader_Type, const std::string&);
 	template void* RHI_Shader::_Compile<RHI_Vertex_Pos>(Shader_Type, const std::string&);
@@ -149,5 +153,7 @@ namespace Spartan
 	template void* RHI_Shader::_Compile<RHI_Vertex_PosCol>(Shader_Type, const std::string&);
 	template void* RHI_Shader::_Compile<RHI_Vertex_Pos2dTexCol8>(Shader_Type, const std::string&);
 	template void* RHI_Shader::_Compile<RHI_Vertex_PosTexNorTan>(Shader_Type, const std::string&);
-	//===============================================================================================================
+	template void* RHI_Shader::_Compile<RHI_Vertex_Pos_InstanceTransform>(Shader_Type, const std::string&);
+	template void* RHI_Shader::_Compile<RHI_Vertex_PosTexNorTan_InstanceTransformHistory>(Shader_Type, const std::string&);
+	//========================================================================================================================================
 }
@@ -21,6 +21,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES =========================
 #include "RHI_Texture.h"
+#include "../IO/Archive.h"
 #include "../IO/FileStream.h"
 #include "../Rendering/Renderer.h"
 #include "../Resource/ResourceCache.h"
@@ -45,53 +46,43 @@ namespace Spartan
 
 	bool RHI_Texture::SaveToFile(const string& file_path)
 	{
-		// Check to see if the file already exists (if so, get the byte count)
-		uint32_t byte_count = 0;
+		// Textures drop their bytes once uploaded, so the ones saved before are carried over,
+		// from the file or from a mounted archive, as the file is about to be overwritten.
+		if (m_data.empty() && (Archive::Exists(file_path) || FileSystem::FileExists(file_path)))
 		{
-			if (FileSystem::FileExists(file_path))
+			auto file = make_unique<FileStream>(file_path, FileStream_Read | FileStream_Mapped);
+			if (!file->IsOpen())
+			{
+				LOGF_ERROR("Failed to read the existing bytes of \"%s\", it won't be overwritten", file_path.c_str());
+				return false;
+			}
+
+			file->Skip(sizeof(uint32_t)); // byte count
+			m_data.resize(file->ReadAs<uint32_t>());
+			for (auto& mip : m_data)
 			{
-				auto file = make_unique<FileStream>(file_path, FileStream_Read);
-				if (file->IsOpen())
-				{
-					file->Read(&byte_count);
-				}
+				const auto bytes = file->ReadView<std::byte>();
+				mip.assign(bytes.begin(), bytes.end());
 			}
 		}
 
-		bool append = true;
-		auto file = make_unique<FileStream>(file_path, FileStream_Write | FileStream_Append);
+		auto file = make_unique<FileStream>(file_path, FileStream_Write);
 		if (!file->IsOpen())
 			return false;
 
-		// If the existing file has a byte count but we 
-		// hold no data, don't overwrite the file's bytes.
-		if (byte_count != 0 && m_data.empty())
+		// Write byte count
+		file->Write(GetByteCount());
+		// Write mipmap count
+		file->Write(static_cast<uint32_t>(m_data.size()));
+		// Write bytes
+		for (auto& mip : m_data)
 		{
-			file->Skip
-			(
-				sizeof(uint32_t) +	// byte count
-				sizeof(uint32_t) +	// mipmap count
-				byte_count				// bytes
-			);
+			file->Write(mip);
 		}
-		else
-		{
-			byte_count = GetByteCount();
-
-			// Write byte count
-			file->Write(byte_count);
-			// Write mipmap count
-			file->Write(static_cast<uint32_t>(m_data.size()));
-			// Write bytes
-			for (auto& mip : m_data)
-			{
-				file->Write(mip);
-			}
 
-			// The bytes have been saved, so we can now free some memory
-			m_data.clear();
-			m_data.shrink_to_fit();
-		}
+		// The bytes have been saved, so we can now free some memory
+		m_data.clear();
+		m_data.shrink_to_fit();
 
 		// Write properties
 		file->Write(m_bpp);
@@ -108,13 +99,18 @@ namespace Spartan
 		return true;
 	}
 
-	bool RHI_Texture::LoadFromFile(const string& rawFilePath)
+	bool RHI_Texture::LoadFromFile(const string& file_path)
+	{
+		return LoadFromFile_Decode(file_path) && LoadFromFile_Finalize();
+	}
+
+	bool RHI_Texture::LoadFromFile_Decode(const string& rawFilePath)
 	{
 		// Make the path relative to the engine
 		auto file_path = FileSystem::GetRelativeFilePath(rawFilePath);
 
 		// Validate file path
-		if (!FileSystem::FileExists(file_path))
+		if (!Archive::Exists(file_path) && !FileSystem::FileExists(file_path))
 		{
 			LOGF_ERROR("Path \"%s\" is invalid.", file_path.c_str());
 			return false;
@@ -142,6 +138,34 @@ namespace Spartan
 			return false;
 		}
 
+		m_data_release_on_upload	= FileSystem::IsEngineTextureFile(file_path);
+		m_load_state				= LoadState_Decoded;
+		return true;
+	}
+
+	bool RHI_Texture::LoadFromMemory_Decode(const string& file_path, vector<std::byte>&& data)
+	{
+		// Only the engine format is read ahead
+		if (!FileSystem::IsEngineTextureFile(file_path))
+			return false;
+
+		m_load_state = LoadState_Started;
+
+		FileStream file(move(data));
+		if (!LoadFromFile_NativeFormat(&file))
+		{
+			LOGF_ERROR("Failed to load \"%s\".", file_path.c_str());
+			m_load_state = LoadState_Failed;
+			return false;
+		}
+
+		m_data_release_on_upload	= true;
+		m_load_state				= LoadState_Decoded;
+		return true;
+	}
+
+	bool RHI_Texture::LoadFromFile_Finalize()
+	{
 		// Create GPU resource
 		if (!CreateResourceGpu())
 		{
@@ -151,7 +175,7 @@ namespace Spartan
 		}
 
 		// Only clear texture bytes if that's an engine texture, if not, it's not serialized yet.
-		if (FileSystem::IsEngineTextureFile(file_path)) 
+		if (m_data_release_on_upload)
 		{
 			m_data.clear();
 			m_data.shrink_to_fit();
@@ -187,10 +211,15 @@ namespace Spartan
 
 	bool RHI_Texture::LoadFromFile_NativeFormat(const string& file_path)
 	{
-		auto file = make_unique<FileStream>(file_path, FileStream_Read);
+		auto file = make_unique<FileStream>(file_path, FileStream_Read | FileStream_Mapped);
 		if (!file->IsOpen())
 			return false;
 
+		return LoadFromFile_NativeFormat(file.get());
+	}
+
+	bool RHI_Texture::LoadFromFile_NativeFormat(FileStream* file)
+	{
 		m_data.clear();
 		m_data.shrink_to_fit();
 
@@ -198,11 +227,12 @@ namespace Spartan
 		auto byte_count		= file->ReadAs<uint32_t>();
 		auto mipmap_count	= file->ReadAs<uint32_t>();
 
-		// Read bytes
+		// Read bytes, every mip is copied out of the file once, into memory of the exact size
 		m_data.resize(mipmap_count);
 		for (auto& mip : m_data)
 		{
-			file->Read(&mip);
+			const auto bytes = file->ReadView<std::byte>();
+			mip.assign(bytes.begin(), bytes.end());
 		}
 
 		// Read properties
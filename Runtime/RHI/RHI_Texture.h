@@ -31,16 +31,21 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Spartan
 {
+	class FileStream;
+
 	class SPARTAN_CLASS RHI_Texture : public RHI_Object, public IResource
 	{
 	public:
 		RHI_Texture(Context* context);
 		~RHI_Texture();
 
-		//= IResource ===========================================
+		//= IResource ====================================================
 		bool SaveToFile(const std::string& file_path) override;
 		bool LoadFromFile(const std::string& file_path) override;
-		//=======================================================
+		bool LoadFromFile_Decode(const std::string& file_path) override;
+		bool LoadFromFile_Finalize() override;
+		bool LoadFromMemory_Decode(const std::string& file_path, std::vector<std::byte>&& data) override;
+		//================================================================
 
 		auto GetWidth() const							{ return m_width; }
 		void SetWidth(const uint32_t width)			{ m_width = width; }
@@ -81,6 +86,7 @@ namespace Spartan
 
 	protected:
 		bool LoadFromFile_NativeFormat(const std::string& file_path);
+		bool LoadFromFile_NativeFormat(FileStream* file);
 		bool LoadFromFile_ForeignFormat(const std::string& file_path, bool generate_mipmaps);
 		uint32_t GetChannelCountFromFormat(RHI_Format format);
 		virtual bool CreateResourceGpu() { return false; }
@@ -97,6 +103,7 @@ namespace Spartan
 		unsigned long m_flags		= 0;
 		RHI_Viewport m_viewport;
 		std::vector<std::vector<std::byte>> m_data;
+		bool m_data_release_on_upload = false; // engine textures are serialized already, there is no need to keep their data
 
 		// Dependencies
 		std::shared_ptr<RHI_Device> m_rhi_device;
@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Math/Vector2.h"
 #include "../Math/Vector3.h"
 #include "../Math/Vector4.h"
+#include "../Math/Matrix.h"
 //==========================
 
 namespace Spartan
@@ -127,11 +128,30 @@ namespace Spartan
 		float tan[3] = { 0 };
 	};
 
+	// Per instance data, read from a second vertex buffer by instanced vertex shaders
+	struct RHI_Instance_Transform
+	{
+		Math::Matrix wvp;
+	};
+
+	struct RHI_Instance_TransformHistory
+	{
+		Math::Matrix world;
+		Math::Matrix wvp_current;
+		Math::Matrix wvp_previous;
+	};
+
+	// Layouts of instanced vertex shaders, the vertex attributes of the vertex type followed by the instance ones
+	struct RHI_Vertex_Pos_InstanceTransform{};
+	struct RHI_Vertex_PosTexNorTan_InstanceTransformHistory{};
+
 	static_assert(std::is_trivially_copyable<RHI_Vertex_Pos>::value,			"RHI_Vertex_Pos is not trivially copyable");
 	static_assert(std::is_trivially_copyable<RHI_Vertex_PosTex>::value,			"RHI_Vertex_PosTex is not trivially copyable");
 	static_assert(std::is_trivially_copyable<RHI_Vertex_PosCol>::value,			"RHI_Vertex_PosCol is not trivially copyable");
 	static_assert(std::is_trivially_copyable<RHI_Vertex_Pos2dTexCol8>::value,	"RHI_Vertex_Pos2dTexCol8 is not trivially copyable");
 	static_assert(std::is_trivially_copyable<RHI_Vertex_PosTexNorTan>::value,	"RHI_Vertex_PosTexNorTan is not trivially copyable");
+	static_assert(std::is_trivially_copyable<RHI_Instance_Transform>::value,		"RHI_Instance_Transform is not trivially copyable");
+	static_assert(std::is_trivially_copyable<RHI_Instance_TransformHistory>::value,	"RHI_Instance_TransformHistory is not trivially copyable");
 
 	enum RHI_Vertex_Type
 	{
@@ -140,7 +160,9 @@ namespace Spartan
 		RHI_Vertex_Type_PositionColor,
 		RHI_Vertex_Type_PositionTexture,
 		RHI_Vertex_Type_PositionTextureNormalTangent,
-		RHI_Vertex_Type_Position2dTextureColor8
+		RHI_Vertex_Type_Position2dTextureColor8,
+		RHI_Vertex_Type_Position_InstanceTransform,
+		RHI_Vertex_Type_PositionTextureNormalTangent_InstanceTransformHistory
 	};
 
 	template <typename T>
@@ -151,4 +173,6 @@ namespace Spartan
 	template<> inline RHI_Vertex_Type RHI_Vertex_Type_To_Enum<RHI_Vertex_PosCol>()			{ return RHI_Vertex_Type_PositionColor; }
 	template<> inline RHI_Vertex_Type RHI_Vertex_Type_To_Enum<RHI_Vertex_Pos2dTexCol8>()	{ return RHI_Vertex_Type_Position2dTextureColor8; }
 	template<> inline RHI_Vertex_Type RHI_Vertex_Type_To_Enum<RHI_Vertex_PosTexNorTan>()	{ return RHI_Vertex_Type_PositionTextureNormalTangent; }
+	template<> inline RHI_Vertex_Type RHI_Vertex_Type_To_Enum<RHI_Vertex_Pos_InstanceTransform>()					{ return RHI_Vertex_Type_Position_InstanceTransform; }
+	template<> inline RHI_Vertex_Type RHI_Vertex_Type_To_Enum<RHI_Vertex_PosTexNorTan_InstanceTransformHistory>()	{ return RHI_Vertex_Type_PositionTextureNormalTangent_InstanceTransformHistory; }
 }
\ No newline at end of file
@@ -26,6 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "RHI_Object.h"
 #include "RHI_Vertex.h"
 #include <vector>
+#include <memory>
 //=========================
 
 namespace Spartan
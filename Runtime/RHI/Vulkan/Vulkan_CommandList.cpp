@@ -181,6 +181,14 @@ namespace Spartan
 		vkCmdDrawIndexed(CMD_LIST, index_count, 1, index_offset, vertex_offset, 0);
 	}
 
+	void RHI_CommandList::DrawIndexedInstanced(const uint32_t index_count, const uint32_t index_offset, const uint32_t vertex_offset, const uint32_t instance_count, const uint32_t instance_offset /*= 0*/)
+	{
+		if (!m_is_recording)
+			return;
+
+		vkCmdDrawIndexed(CMD_LIST, index_count, instance_count, index_offset, vertex_offset, instance_offset);
+	}
+
 	void RHI_CommandList::SetPipeline(RHI_Pipeline* pipeline)
 	{
 		if (!m_is_recording)
@@ -248,14 +256,14 @@ namespace Spartan
 			return;
 	}
 
-	void RHI_CommandList::SetBufferVertex(const RHI_VertexBuffer* buffer)
+	void RHI_CommandList::SetBufferVertex(const RHI_VertexBuffer* buffer, const uint32_t slot /*= 0*/)
 	{
 		if (!m_is_recording)
 			return;
 
 		VkBuffer vertex_buffers[]	= { static_cast<VkBuffer>(buffer->GetResource()) };
 		VkDeviceSize offsets[]		= { 0 };
-		vkCmdBindVertexBuffers(CMD_LIST, 0, 1, vertex_buffers, offsets);
+		vkCmdBindVertexBuffers(CMD_LIST, slot, 1, vertex_buffers, offsets);
 	}
 
 	void RHI_CommandList::SetBufferIndex(const RHI_IndexBuffer* buffer)
@@ -296,6 +304,12 @@ namespace Spartan
 
 	}
 
+	void RHI_CommandList::SetConstantBufferData(const uint32_t slot, const RHI_Buffer_Scope scope, const void* data, const uint32_t size)
+	{
+		if (!m_is_recording)
+			return;
+	}
+
 	void RHI_CommandList::SetSamplers(const uint32_t start_slot, const vector<void*>& samplers)
 	{
 		if (!m_is_recording)
@@ -361,6 +375,24 @@ namespace Spartan
 			return;
 	}
 
+	void RHI_CommandList::CopyTexture(RHI_Texture* source, RHI_Texture* destination, const uint32_t array_index /*= 0*/)
+	{
+		if (!m_is_recording)
+			return;
+	}
+
+	bool RHI_CommandList::IsCopySupported()
+	{
+		// Not implemented yet, see CopyTexture()
+		return false;
+	}
+
+	void RHI_CommandList::Append(RHI_CommandList& cmd_list)
+	{
+		if (!m_is_recording)
+			return;
+	}
+
 	bool RHI_CommandList::Submit()
 	{
 		// Ensure the command list has stopped recording
@@ -42,7 +42,7 @@ namespace Spartan
 		Vulkan_Common::memory::free(m_rhi_device, m_buffer_memory);
 	}
 
-	void* RHI_ConstantBuffer::Map() const
+	void* RHI_ConstantBuffer::Map(bool /*discard = true*/) const
 	{
 		if (!m_rhi_device || !m_rhi_device->GetContext()->device || !m_buffer_memory)
 		{
@@ -179,11 +179,19 @@ namespace Spartan
 		ReflectShaders();
 		CreateDescriptorSetLayout();
 
-		// Binding description
-		VkVertexInputBindingDescription binding_description = {};
-		binding_description.binding		= 0;
-		binding_description.inputRate	= VK_VERTEX_INPUT_RATE_VERTEX;
-		binding_description.stride		= m_state->vertex_buffer->GetStride();
+		// Binding descriptions, instanced shaders read per instance data from a second binding
+		vector<VkVertexInputBindingDescription> binding_descriptions(1);
+		binding_descriptions[0].binding		= 0;
+		binding_descriptions[0].inputRate	= VK_VERTEX_INPUT_RATE_VERTEX;
+		binding_descriptions[0].stride		= m_state->vertex_buffer->GetStride();
+		if (const auto instance_stride = m_state->input_layout->GetInstanceStride())
+		{
+			VkVertexInputBindingDescription binding_description = {};
+			binding_description.binding		= 1;
+			binding_description.inputRate	= VK_VERTEX_INPUT_RATE_INSTANCE;
+			binding_description.stride		= instance_stride;
+			binding_descriptions.emplace_back(binding_description);
+		}
 
 		// Vertex attributes description
 		vector<VkVertexInputAttributeDescription> vertex_attribute_descs;
@@ -195,8 +203,8 @@ namespace Spartan
 		// Vertex input state
 		VkPipelineVertexInputStateCreateInfo vertex_input_state = {};
 		vertex_input_state.sType								= VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-		vertex_input_state.vertexBindingDescriptionCount		= 1;
-		vertex_input_state.pVertexBindingDescriptions			= &binding_description;
+		vertex_input_state.vertexBindingDescriptionCount		= static_cast<uint32_t>(binding_descriptions.size());
+		vertex_input_state.pVertexBindingDescriptions			= binding_descriptions.data();
 		vertex_input_state.vertexAttributeDescriptionCount		= static_cast<uint32_t>(vertex_attribute_descs.size());
 		vertex_input_state.pVertexAttributeDescriptions			= vertex_attribute_descs.data();
 
@@ -90,8 +90,8 @@ namespace Spartan
 	{
 		m_type		= type;
 		m_context	= context;
-		m_renderer	= context->GetSubsystem<Renderer>().get();
-		m_input		= context->GetSubsystem<Input>().get();
+		m_renderer	= context->GetSubsystem<Renderer>();
+		m_input		= context->GetSubsystem<Input>();
 
 		m_ray_previous	= Vector3::Zero;
 		m_ray_current	= Vector3::Zero;
@@ -38,8 +38,8 @@ namespace Spartan
 	Transform_Gizmo::Transform_Gizmo(Context* context)
 	{
 		m_context		= context;
-		m_input			= m_context->GetSubsystem<Input>().get();
-		m_world			= m_context->GetSubsystem<World>().get();
+		m_input			= m_context->GetSubsystem<Input>();
+		m_world			= m_context->GetSubsystem<World>();
 		m_type			= TransformHandle_Position;
 		m_space			= TransformHandle_World;
 		m_is_editing	= false;
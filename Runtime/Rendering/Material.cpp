@@ -25,7 +25,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Deferred/ShaderVariation.h"
 #include "../Resource/ResourceCache.h"
 #include "../IO/XmlDocument.h"
-#include "../RHI/RHI_ConstantBuffer.h"
 #include "../RHI/RHI_Texture2D.h"
 #include "../RHI/RHI_TextureCube.h"
 //====================================
@@ -355,41 +354,20 @@ namespace Spartan
 		}
 	}
 
-	void Material::UpdateConstantBuffer()
+	Material::ConstantBufferData Material::GetConstantBufferData() const
 	{
-		// Has to match GBuffer.hlsl
-		if (!m_constant_buffer_gpu)
-		{
-			m_constant_buffer_gpu = make_shared<RHI_ConstantBuffer>(m_rhi_device);
-			m_constant_buffer_gpu->Create<ConstantBufferData>();
-		}
-
-		// Determine if the buffer needs to update
-		auto update = false;
-		update = m_constant_buffer_cpu.mat_albedo			!= GetColorAlbedo() 		? true : update;
-		update = m_constant_buffer_cpu.mat_tiling_uv		!= GetTiling()				? true : update;
-		update = m_constant_buffer_cpu.mat_offset_uv		!= GetOffset()				? true : update;
-		update = m_constant_buffer_cpu.mat_roughness_mul	!= GetRoughnessMultiplier() ? true : update;
-		update = m_constant_buffer_cpu.mat_metallic_mul		!= GetMetallicMultiplier()	? true : update;
-		update = m_constant_buffer_cpu.mat_normal_mul		!= GetNormalMultiplier()	? true : update;
-		update = m_constant_buffer_cpu.mat_shading_mode		!= float(GetShadingMode())	? true : update;
-
-		if (!update)
-			return;
-
-		auto buffer = static_cast<ConstantBufferData*>(m_constant_buffer_gpu->Map());
-
-		buffer->mat_albedo			= m_constant_buffer_cpu.mat_albedo			= GetColorAlbedo();
-		buffer->mat_tiling_uv		= m_constant_buffer_cpu.mat_tiling_uv		= GetTiling();
-		buffer->mat_offset_uv		= m_constant_buffer_cpu.mat_offset_uv		= GetOffset();
-		buffer->mat_roughness_mul	= m_constant_buffer_cpu.mat_roughness_mul	= GetRoughnessMultiplier();
-		buffer->mat_metallic_mul	= m_constant_buffer_cpu.mat_metallic_mul	= GetMetallicMultiplier();
-		buffer->mat_normal_mul		= m_constant_buffer_cpu.mat_normal_mul		= GetNormalMultiplier();
-		buffer->mat_height_mul		= m_constant_buffer_cpu.mat_normal_mul		= GetHeightMultiplier();
-		buffer->mat_shading_mode	= m_constant_buffer_cpu.mat_shading_mode	= float(GetShadingMode());
-		buffer->padding				= m_constant_buffer_cpu.padding				= Vector3::Zero;
-
-		m_constant_buffer_gpu->Unmap();
+		ConstantBufferData buffer;
+		buffer.mat_albedo			= m_color_albedo;
+		buffer.mat_tiling_uv		= m_uv_tiling;
+		buffer.mat_offset_uv		= m_uv_offset;
+		buffer.mat_roughness_mul	= m_roughness_multiplier;
+		buffer.mat_metallic_mul		= m_metallic_multiplier;
+		buffer.mat_normal_mul		= m_normal_multiplier;
+		buffer.mat_height_mul		= m_height_multiplier;
+		buffer.mat_shading_mode		= float(m_shading_mode);
+		buffer.padding				= Vector3::Zero;
+
+		return buffer;
 	}
 
 	TextureType Material::TextureTypeFromString(const string& type)
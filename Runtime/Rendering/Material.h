@@ -136,10 +136,22 @@ namespace Spartan
 
 		static TextureType TextureTypeFromString(const std::string& type);
 
-		//= CONSTANT BUFFER =============================================
-		void UpdateConstantBuffer();
-		const auto& GetConstantBuffer() { return m_constant_buffer_gpu; }
-		//===============================================================
+		//= CONSTANT BUFFER ===============================
+		// Has to match GBuffer.hlsl
+		struct ConstantBufferData
+		{
+			Math::Vector4 mat_albedo;
+			Math::Vector2 mat_tiling_uv;
+			Math::Vector2 mat_offset_uv;
+			float mat_roughness_mul;
+			float mat_metallic_mul;
+			float mat_normal_mul;
+			float mat_height_mul;
+			float mat_shading_mode;
+			Math::Vector3 padding;
+		};
+		ConstantBufferData GetConstantBufferData() const;
+		//=================================================
 
 	private:
 		void TextureBasedMultiplierAdjustment();	
@@ -158,21 +170,5 @@ namespace Spartan
 		std::vector<TextureSlot> m_texture_slots;
 		TextureSlot m_empty_texture_slot;
 		std::shared_ptr<RHI_Device> m_rhi_device;
-
-		// BUFFER
-		struct ConstantBufferData
-		{
-			Math::Vector4 mat_albedo;
-			Math::Vector2 mat_tiling_uv;
-			Math::Vector2 mat_offset_uv;
-			float mat_roughness_mul;
-			float mat_metallic_mul;
-			float mat_normal_mul;
-			float mat_height_mul;
-			float mat_shading_mode;
-			Math::Vector3 padding;
-		};
-		ConstantBufferData m_constant_buffer_cpu;
-		std::shared_ptr<RHI_ConstantBuffer> m_constant_buffer_gpu;
 	};
 }
\ No newline at end of file
@@ -48,7 +48,7 @@ namespace Spartan
 	{
 		m_normalized_scale	= 1.0f;
 		m_is_animated		= false;
-		m_resource_manager	= m_context->GetSubsystem<ResourceCache>().get();
+		m_resource_manager	= m_context->GetSubsystem<ResourceCache>();
 		m_rhi_device		= m_context->GetSubsystem<Renderer>()->GetRhiDevice();
 		m_mesh				= make_unique<Mesh>();
 	}
@@ -64,6 +64,11 @@ namespace Spartan
 
 	//= RESOURCE ============================================
 	bool Model::LoadFromFile(const string& file_path)
+	{
+		return LoadFromFile_Decode(file_path) && LoadFromFile_Finalize();
+	}
+
+	bool Model::LoadFromFile_Decode(const string& file_path)
 	{
 		Stopwatch timer;
 		auto model_file_path = file_path;
@@ -87,12 +92,35 @@ namespace Spartan
 		const auto engine_format = FileSystem::GetExtensionFromFilePath(model_file_path) == EXTENSION_MODEL;
 		const auto success = engine_format ? LoadFromEngineFormat(model_file_path) : LoadFromForeignFormat(model_file_path);
 
-		GeometryComputeMemoryUsage();
 		LOGF_INFO("Loading \"%s\" took %d ms", FileSystem::GetFileNameFromFilePath(file_path).c_str(), static_cast<int>(timer.GetElapsedTimeMs()));
 
 		return success;
 	}
 
+	bool Model::LoadFromMemory_Decode(const string& file_path, vector<std::byte>&& data)
+	{
+		// Only the engine format is read ahead
+		if (!FileSystem::IsEngineModelFile(file_path))
+			return false;
+
+		FileStream file(move(data));
+		return LoadFromEngineFormat(&file);
+	}
+
+	bool Model::LoadFromFile_Finalize()
+	{
+		// Imported models went through GeometryUpdate(), which created the buffers already
+		if (!m_index_buffer || !m_vertex_buffer)
+		{
+			if (!GeometryCreateBuffers())
+				return false;
+		}
+
+		GeometryComputeMemoryUsage();
+
+		return true;
+	}
+
 	bool Model::SaveToFile(const string& file_path)
 	{
 		auto file = make_unique<FileStream>(file_path, FileStream_Write);
@@ -236,18 +264,26 @@ namespace Spartan
 
 	bool Model::LoadFromEngineFormat(const string& file_path)
 	{
-		// Deserialize
-		auto file = make_unique<FileStream>(file_path, FileStream_Read);
+		auto file = make_unique<FileStream>(file_path, FileStream_Read | FileStream_Mapped);
 		if (!file->IsOpen())
 			return false;
 
+		return LoadFromEngineFormat(file.get());
+	}
+
+	bool Model::LoadFromEngineFormat(FileStream* file)
+	{
+		// Deserialize
 		SetResourceName(file->ReadAs<string>());
 		SetResourceFilePath(file->ReadAs<string>());
 		file->Read(&m_normalized_scale);
+
 		file->Read(&m_mesh->Indices_Get());
 		file->Read(&m_mesh->Vertices_Get());
 
-		GeometryUpdate();
+		// Same as GeometryUpdate(), except for the GPU buffers, they are created once the load is finalized
+		m_normalized_scale	= GeometryComputeNormalizedScale();
+		m_aabb				= BoundingBox(m_mesh->Vertices_Get());
 
 		return true;
 	}
@@ -281,8 +317,8 @@ namespace Spartan
 		auto success = true;
 
 		// Get geometry
-		auto indices	= m_mesh->Indices_Get();
-		auto vertices	= m_mesh->Vertices_Get();
+		const auto& indices		= m_mesh->Indices_Get();
+		const auto& vertices	= m_mesh->Vertices_Get();
 
 		if (!indices.empty())
 		{
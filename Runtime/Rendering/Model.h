@@ -36,6 +36,7 @@ namespace Spartan
 	class Entity;
 	class Mesh;
 	class Animation;
+	class FileStream;
 
 	namespace Math
 	{
@@ -48,10 +49,13 @@ namespace Spartan
 		Model(Context* context);
 		~Model();
 
-		//= RESOURCE INTERFACE =================================
+		//= RESOURCE INTERFACE ===========================================
 		bool LoadFromFile(const std::string& file_path) override;
+		bool LoadFromFile_Decode(const std::string& file_path) override;
+		bool LoadFromFile_Finalize() override;
+		bool LoadFromMemory_Decode(const std::string& file_path, std::vector<std::byte>&& data) override;
 		bool SaveToFile(const std::string& file_path) override;
-		//======================================================
+		//================================================================
 
 		// Sets the entity that represents this model in the scene
 		void SetRootentity(const std::shared_ptr<Entity>& entity) { m_root_entity = entity; }
@@ -91,6 +95,7 @@ namespace Spartan
 	private:
 		// Load the model from disk
 		bool LoadFromEngineFormat(const std::string& file_path);
+		bool LoadFromEngineFormat(FileStream* file);
 		bool LoadFromForeignFormat(const std::string& file_path);
 
 		// Geometry
@@ -22,14 +22,19 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES ==============================
 #include "Renderer.h"
 #include <algorithm>
+#include "Material.h"
+#include "Model.h"
 #include "ShaderBuffered.h"
+#include "Deferred/ShaderVariation.h"
 #include "Gizmos/Grid.h"
 #include "Gizmos/Transform_Gizmo.h"
 #include "Deferred/ShaderLight.h"
 #include "Utilities/Sampling.h"
 #include "Font/Font.h"
 #include "../Profiling/Profiler.h"
+#include "../Threading/Threading.h"
 #include "../Resource/ResourceCache.h"
+#include "../World/World.h"
 #include "../World/Entity.h"
 #include "../World/Components/Transform.h"
 #include "../World/Components/Renderable.h"
@@ -89,20 +94,20 @@ namespace Spartan
 		m_pipeline_cache = make_shared<RHI_PipelineCache>(m_rhi_device);
 
 		// Create command list
-		m_cmd_list = make_shared<RHI_CommandList>(m_rhi_device, m_context->GetSubsystem<Profiler>().get());
+		m_cmd_list = make_shared<RHI_CommandList>(m_rhi_device, m_context->GetSubsystem<Profiler>());
 
 		// Log on-screen as the renderer is ready
 		LOG_TO_FILE(false);
 		m_initialized = true;
 
 		// Subscribe to events
-		SUBSCRIBE_TO_EVENT(Event_World_Submit, EVENT_HANDLER_VARIANT(RenderablesAcquire));
+		m_subscription_world_submit = SUBSCRIBE_TO_EVENT(Event_World_Submit, EVENT_HANDLER_VARIANT(RenderablesAcquire));
 	}
 
 	Renderer::~Renderer()
 	{
 		// Unsubscribe from events
-		UNSUBSCRIBE_FROM_EVENT(Event_World_Submit, EVENT_HANDLER_VARIANT(RenderablesAcquire));
+		UNSUBSCRIBE_FROM_EVENT(Event_World_Submit, m_subscription_world_submit);
 
 		m_entities.clear();
 		m_camera = nullptr;
@@ -114,8 +119,15 @@ namespace Spartan
 	bool Renderer::Initialize()
 	{
 		// Create/Get required systems		
-		g_resource_cache	= m_context->GetSubsystem<ResourceCache>().get();
-		m_profiler			= m_context->GetSubsystem<Profiler>().get();
+		g_resource_cache	= m_context->GetSubsystem<ResourceCache>();
+		m_profiler			= m_context->GetSubsystem<Profiler>();
+		m_threading			= m_context->GetSubsystem<Threading>();
+
+		// Command lists for parallel recording, one for every worker plus the calling thread
+		for (uint32_t i = 0; i < m_threading->GetThreadCount() + 1; i++)
+		{
+			m_cmd_lists_parallel.emplace_back(make_shared<RHI_CommandList>(m_rhi_device, m_profiler));
+		}
 
 		// Editor specific
 		m_gizmo_grid		= make_unique<Grid>(m_rhi_device);
@@ -154,6 +166,7 @@ namespace Spartan
 		m_rasterizer_cull_back_wireframe	= make_shared<RHI_RasterizerState>(m_rhi_device, Cull_Back,		Fill_Wireframe,	true, false, false, true);
 		m_rasterizer_cull_front_wireframe	= make_shared<RHI_RasterizerState>(m_rhi_device, Cull_Front,	Fill_Wireframe,	true, false, false, true);
 		m_rasterizer_cull_none_wireframe	= make_shared<RHI_RasterizerState>(m_rhi_device, Cull_None,		Fill_Wireframe,	true, false, false, true);
+		m_rasterizer_cull_back_solid_no_clip = make_shared<RHI_RasterizerState>(m_rhi_device, Cull_Back,	Fill_Solid,		false, false, false, false);
 	}
 
 	void Renderer::CreateBlendStates()
@@ -255,7 +268,6 @@ namespace Spartan
 		// Transparent
 		m_vps_transparent = make_shared<ShaderBuffered>(m_rhi_device);
 		m_vps_transparent->CompileAsync<RHI_Vertex_PosTexNorTan>(m_context, Shader_VertexPixel, dir_shaders + "Transparent.hlsl");
-		m_vps_transparent->AddBuffer<Struct_Transparency>();
 
 		// Font
 		m_vps_font = make_shared<ShaderBuffered>(m_rhi_device);
@@ -299,11 +311,11 @@ namespace Spartan
 
 		// G-Buffer
 		m_vs_gbuffer = make_shared<RHI_Shader>(m_rhi_device);
-		m_vs_gbuffer->CompileAsync<RHI_Vertex_PosTexNorTan>(m_context, Shader_Vertex, dir_shaders + "GBuffer.hlsl");
+		m_vs_gbuffer->CompileAsync<RHI_Vertex_PosTexNorTan_InstanceTransformHistory>(m_context, Shader_Vertex, dir_shaders + "GBuffer.hlsl");
 
 		// Position
 		m_v_depth = make_shared<RHI_Shader>(m_rhi_device);
-		m_v_depth->CompileAsync<RHI_Vertex_Pos>(m_context, Shader_Vertex, dir_shaders + "Depth.hlsl");
+		m_v_depth->CompileAsync<RHI_Vertex_Pos_InstanceTransform>(m_context, Shader_Vertex, dir_shaders + "Depth.hlsl");
 
 		// Quad
 		m_vs_quad = make_shared<RHI_Shader>(m_rhi_device);
@@ -496,6 +508,8 @@ namespace Spartan
 			m_view_projection_orthographic	= m_view_base * m_projection_orthographic;
 		}
 
+		RenderablesCull();
+
 		Pass_Main();
 
 		m_is_rendering = false;
@@ -599,107 +613,302 @@ namespace Spartan
 		m_buffer_global->Unmap();
 	}
 
-	void Renderer::RenderablesAcquire(const Variant& entities_variant)
+	void Renderer::RenderablesAcquire(const Variant& changes_variant)
 	{
 		TIME_BLOCK_START_CPU(m_profiler);
 
+		const auto& changes = *changes_variant.Get<const WorldChanges*>();
+
 		// Clear previous state
-		m_entities.clear();
-		m_camera = nullptr;
-		m_skybox = nullptr;
-		
-		auto entities_vec = entities_variant.Get<vector<shared_ptr<Entity>>>();
-		for (const auto& entitieshared : entities_vec)
+		if (changes.reset)
+		{
+			m_entities.clear();
+			m_entities_index.clear();
+			m_entities_aabb.clear();
+			m_entities_aabb_version.clear();
+			m_camera = nullptr;
+			m_skybox = nullptr;
+			m_shadow_casters.clear();
+		}
+
+		// Only the entities which changed are re-classified
+		for (const auto& entity : changes.entities_changed)
+		{
+			RenderablesRemove(entity.get());
+			RenderablesAdd(entity.get());
+		}
+
+		for (const auto& entity : changes.entities_removed)
+		{
+			RenderablesRemove(entity.get());
+		}
+
+		TIME_BLOCK_END(m_profiler);
+	}
+
+	void Renderer::RenderablesAdd(Entity* entity)
+	{
+		// Get all the components we are interested in (raw, no reference counting per entity)
+		auto renderable = entity->GetComponent_PtrRaw<Renderable>();
+		auto light		= entity->GetComponent_PtrRaw<Light>();
+		auto skybox		= entity->GetComponent_PtrRaw<Skybox>();
+		auto camera		= entity->GetComponent_PtrRaw<Camera>();
+
+		// Entities are appended, the visible ones are sorted every frame anyway
+		const auto append = [this, entity](const RenderableType type)
 		{
-			auto entity = entitieshared.get();
-			if (!entity)
+			auto& entities		= m_entities[type];
+			const auto index	= static_cast<uint32_t>(entities.size());
+			m_entities_index[type][entity] = index;
+			entities.emplace_back(entity);
+
+			// Objects also get their box packed for culling
+			if (type == Renderable_ObjectOpaque || type == Renderable_ObjectTransparent)
+			{
+				auto& boxes = m_entities_aabb[type];
+				boxes.Resize(index + 1);
+				boxes.Set(index, entity->GetRenderable_PtrRaw()->GeometryAabb());
+				m_entities_aabb_version[type].emplace_back(entity->GetTransform_PtrRaw()->GetVersion());
+			}
+		};
+
+		if (renderable && !skybox) // Ignore skybox
+		{
+			const auto is_transparent = !renderable->MaterialExists() ? false : renderable->MaterialPtr()->GetColorAlbedo().w < 1.0f;
+			append(is_transparent ? Renderable_ObjectTransparent : Renderable_ObjectOpaque);
+
+			// New casters start as static
+			if (!is_transparent)
+			{
+				m_shadow_casters.emplace_back(ShadowCaster{ entity->GetTransform_PtrRaw()->GetVersion(), m_shadow_caster_static_frames, ++m_shadow_caster_stamp });
+			}
+		}
+
+		if (light)
+		{
+			append(Renderable_Light);
+		}
+
+		if (skybox)
+		{
+			m_skybox = entity->GetComponent<Skybox>();
+		}
+
+		if (camera)
+		{
+			append(Renderable_Camera);
+			m_camera = entity->GetComponent<Camera>();
+		}
+	}
+
+	void Renderer::RenderablesRemove(Entity* entity)
+	{
+		for (auto& bucket : m_entities_index)
+		{
+			auto& index_lookup	= bucket.second;
+			const auto it		= index_lookup.find(entity);
+			if (it == index_lookup.end())
 				continue;
 
-			// Get all the components we are interested in
-			auto renderable = entity->GetComponent<Renderable>();
-			auto light		= entity->GetComponent<Light>();
-			auto skybox		= entity->GetComponent<Skybox>();
-			auto camera		= entity->GetComponent<Camera>();
+			// Swap with the last entity and pop
+			auto& entities		= m_entities[bucket.first];
+			const auto index	= it->second;
+			const auto last		= static_cast<uint32_t>(entities.size() - 1);
+			index_lookup.erase(it);
+			if (index != last)
+			{
+				entities[index]					= entities[last];
+				index_lookup[entities[index]]	= index;
+			}
+			entities.pop_back();
 
-			if (renderable)
+			// So do the packed boxes
+			if (bucket.first == Renderable_ObjectOpaque || bucket.first == Renderable_ObjectTransparent)
 			{
-				const auto is_transparent = !renderable->MaterialExists() ? false : renderable->MaterialPtr()->GetColorAlbedo().w < 1.0f;
-				if (!skybox) // Ignore skybox
+				auto& boxes		= m_entities_aabb[bucket.first];
+				auto& versions	= m_entities_aabb_version[bucket.first];
+				if (last < versions.size())
 				{
-					m_entities[is_transparent ? Renderable_ObjectTransparent : Renderable_ObjectOpaque].emplace_back(entity);
+					boxes.Copy(last, index);
+					boxes.Resize(last);
+					versions[index] = versions[last];
+					versions.pop_back();
 				}
 			}
 
-			if (light)
+			// The caster data follows the opaque entities, the caches which held it notice as their signature no longer matches
+			if (bucket.first == Renderable_ObjectOpaque && last < m_shadow_casters.size())
 			{
-				m_entities[Renderable_Light].emplace_back(entity);
+				m_shadow_casters[index] = m_shadow_casters[last];
+				m_shadow_casters.pop_back();
 			}
+		}
 
-			if (skybox)
+		if (m_skybox && m_skybox->GetEntity_PtrRaw() == entity)
+		{
+			m_skybox = nullptr;
+		}
+
+		if (m_camera && m_camera->GetEntity_PtrRaw() == entity)
+		{
+			const auto& cameras	= m_entities[Renderable_Camera];
+			m_camera			= !cameras.empty() ? cameras.back()->GetComponent<Camera>() : nullptr;
+		}
+	}
+
+	void Renderer::RenderablesCull()
+	{
+		TIME_BLOCK_START_CPU(m_profiler);
+
+		for (const auto type : { Renderable_ObjectOpaque, Renderable_ObjectTransparent })
+		{
+			const auto& entities	= m_entities[type];
+			auto& boxes				= m_entities_aabb[type];
+			auto& versions			= m_entities_aabb_version[type];
+
+			// The boxes are packed as entities come and go, only the ones whose transform has changed are refreshed
+			const auto count = static_cast<uint32_t>(entities.size());
+			if (versions.size() != count)
 			{
-				m_skybox = skybox;
+				boxes.Resize(count);
+				versions.assign(count, 0);
+				for (uint32_t i = 0; i < count; i++)
+				{
+					auto renderable = entities[i]->GetRenderable_PtrRaw();
+					boxes.Set(i, renderable ? renderable->GeometryAabb() : BoundingBox::Zero);
+					versions[i] = entities[i]->GetTransform_PtrRaw()->GetVersion();
+				}
 			}
-
-			if (camera)
+			for (uint32_t i = 0; i < count; i++)
 			{
-				m_entities[Renderable_Camera].emplace_back(entity);
-				m_camera = camera;
+				const auto version = entities[i]->GetTransform_PtrRaw()->GetVersion();
+				if (version == versions[i])
+					continue;
+
+				auto renderable = entities[i]->GetRenderable_PtrRaw();
+				boxes.Set(i, renderable ? renderable->GeometryAabb() : BoundingBox::Zero);
+				versions[i] = version;
 			}
+
+			m_camera->GetFrustum().CheckCubes(boxes, &m_entities_visible[type]);
+			RenderablesSort(type);
 		}
 
-		RenderablesSort(&m_entities[Renderable_ObjectOpaque]);
-		RenderablesSort(&m_entities[Renderable_ObjectTransparent]);
+		// Classify the shadow casters
+		const auto& entities = m_entities[Renderable_ObjectOpaque];
+		if (m_shadow_casters.size() != entities.size())
+		{
+			m_shadow_casters.resize(entities.size());
+			for (uint32_t i = 0; i < static_cast<uint32_t>(entities.size()); i++)
+			{
+				m_shadow_casters[i] = ShadowCaster{ entities[i]->GetTransform_PtrRaw()->GetVersion(), m_shadow_caster_static_frames, ++m_shadow_caster_stamp };
+			}
+		}
+		for (uint32_t i = 0; i < static_cast<uint32_t>(entities.size()); i++)
+		{
+			const auto version	= entities[i]->GetTransform_PtrRaw()->GetVersion();
+			auto& caster		= m_shadow_casters[i];
+			if (version != caster.transform_version)
+			{
+				// A caster started moving, if it was static it's baked in the caches at its old place
+				caster.transform_version	= version;
+				caster.still_frames			= 0;
+				caster.stamp				= ++m_shadow_caster_stamp;
+			}
+			else if (caster.still_frames < m_shadow_caster_static_frames)
+			{
+				// A dynamic caster settles, once static it has to be baked in the caches that cover it
+				caster.still_frames++;
+			}
+		}
 
 		TIME_BLOCK_END(m_profiler);
 	}
 
-	void Renderer::RenderablesSort(vector<Entity*>* renderables)
+	void Renderer::RecordParallel(const uint32_t count, const function<void(RHI_CommandList*, uint32_t, uint32_t)>& record)
 	{
-		if (renderables->size() <= 2)
+		// Small ranges aren't worth the overhead
+		const uint32_t chunk_min	= 64;
+		const auto chunk_count		= Min(count / chunk_min, static_cast<uint32_t>(m_cmd_lists_parallel.size()));
+		if (chunk_count <= 1)
+		{
+			record(m_cmd_list.get(), 0, count);
 			return;
+		}
 
-		// Sort by depth (front to back)
-		if (m_camera)
+		const auto chunk_size = (count + chunk_count - 1) / chunk_count;
+		m_threading->ParallelFor(chunk_count, 1, [this, &record, chunk_size, count](const uint32_t chunk)
 		{
-			sort(renderables->begin(), renderables->end(), [this](Entity* a, Entity* b)
-			{
-				// Get renderable component
-				auto a_renderable = a->GetRenderable_PtrRaw();
-				auto b_renderable = b->GetRenderable_PtrRaw();
-				if (!a_renderable || !b_renderable)
-					return false;
-
-				// Get materials
-				const auto a_material = a_renderable->MaterialPtr();
-				const auto b_material = b_renderable->MaterialPtr();
-				if (!a_material || !b_material)
-					return false;
-
-				const auto a_depth = (a_renderable->GeometryAabb().GetCenter() - m_camera->GetTransform()->GetPosition()).LengthSquared();
-				const auto b_depth = (b_renderable->GeometryAabb().GetCenter() - m_camera->GetTransform()->GetPosition()).LengthSquared();
-
-				return a_depth < b_depth;
-			});
+			const auto start	= chunk * chunk_size;
+			const auto end		= Min(start + chunk_size, count);
+			record(m_cmd_lists_parallel[chunk].get(), start, end);
+		});
+
+		for (uint32_t chunk = 0; chunk < chunk_count; chunk++)
+		{
+			m_cmd_list->Append(*m_cmd_lists_parallel[chunk]);
 		}
+	}
+
+	void Renderer::RenderablesSort(const RenderableType type)
+	{
+		auto& visible = m_entities_visible[type];
+		if (visible.size() < 2)
+			return;
 
-		// Sort by material
-		sort(renderables->begin(), renderables->end(), [](Entity* a, Entity* b)
+		// Folds a 32-bit id into its lowest bits, a collision only costs a state change as the passes compare the full ids
+		const auto fold = [](const uint32_t id, const uint32_t bits)
 		{
-			// Get renderable component
-			const auto a_renderable = a->GetRenderable_PtrRaw();
-			const auto b_renderable = b->GetRenderable_PtrRaw();
-			if (!a_renderable || !b_renderable)
-				return false;
-
-			// Get materials
-			const auto a_material = a_renderable->MaterialPtr();
-			const auto b_material = b_renderable->MaterialPtr();
-			if (!a_material || !b_material)
-				return false;
-
-			// Order doesn't matter, as long as they are not mixed
-			return a_material->GetResourceId() < b_material->GetResourceId();
+			const uint64_t hash = id * 0x9E3779B1u;
+			return (hash >> (32 - bits)) & ((1ull << bits) - 1);
+		};
+
+		const auto& entities		= m_entities[type];
+		const auto& boxes			= m_entities_aabb[type];
+		const Vector3 camera_pos	= m_camera->GetTransform()->GetPosition();
+		const float depth_scale		= m_far_plane > 0.0f ? 1.0f / m_far_plane : 0.0f;
+		const bool transparent		= type == Renderable_ObjectTransparent;
+
+		m_draw_keys.resize(visible.size());
+		m_threading->ParallelFor(static_cast<uint32_t>(visible.size()), 1024, [&](const uint32_t i)
+		{
+			const auto index		= visible[i];
+			const auto renderable	= entities[index]->GetRenderable_PtrRaw();
+			const auto material		= renderable ? renderable->Material_PtrRaw() : nullptr;
+			const auto shader		= material ? material->GetShader().get() : nullptr;
+			const auto model		= renderable ? renderable->GeometryModel_PtrRaw() : nullptr;
+
+			// Distance to the camera as a fraction of the far plane, quantized to 24 bits
+			const Vector3 center	= Vector3(boxes.center_x[index], boxes.center_y[index], boxes.center_z[index]);
+			const float distance	= Clamp((center - camera_pos).Length() * depth_scale, 0.0f, 1.0f);
+			const uint64_t depth	= static_cast<uint64_t>(distance * 16777215.0f);
+
+			const uint64_t shader_id	= fold(shader ? shader->RHI_GetID() : 0, 10);
+			const uint64_t material_id	= fold(material ? material->GetResourceId() : 0, 16);
+			// The sub-mesh is part of the geometry, draws of the same sub-mesh and material get instanced together
+			const uint64_t model_id		= fold(model ? model->GetResourceId() ^ (renderable->GeometryIndexOffset() * 0x9E3779B1u) : 0, 14);
+
+			uint64_t key;
+			if (transparent)
+			{
+				// Back to front, blending needs it
+				key = ((16777215 - depth) << 40) | (shader_id << 30) | (material_id << 14) | model_id;
+			}
+			else
+			{
+				// Grouped by state, most expensive change first, then front to back to help early z
+				key = (shader_id << 54) | (material_id << 38) | (model_id << 24) | depth;
+			}
+
+			m_draw_keys[i] = { key, index };
 		});
+
+		Utility::Sorting::RadixSort(m_draw_keys, m_draw_keys_scratch, m_threading);
+
+		for (uint32_t i = 0; i < static_cast<uint32_t>(visible.size()); i++)
+		{
+			visible[i] = m_draw_keys[i].index;
+		}
 	}
 
 	shared_ptr<RHI_RasterizerState>& Renderer::GetRasterizerState(const RHI_Cull_Mode cull_mode, const RHI_Fill_Mode fill_mode)
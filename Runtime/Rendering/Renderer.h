@@ -24,19 +24,25 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //= INCLUDES =====================
 #include <memory>
 #include <vector>
+#include <functional>
 #include <unordered_map>
 #include "../Core/ISubsystem.h"
+#include "../Core/EventSystem.h"
 #include "../Math/Matrix.h"
 #include "../Math/Vector2.h"
 #include "../Math/Rectangle.h"
+#include "../Math/Frustum.h"
 #include "../Core/Settings.h"
 #include "../RHI/RHI_Definition.h"
 #include "../RHI/RHI_Viewport.h"
+#include "../RHI/RHI_Vertex.h"
+#include "Utilities/Sorting.h"
 //================================
 
 namespace Spartan
 {
 	class Entity;
+	class Renderable;
 	class Camera;
 	class Skybox;
 	class Light;
@@ -48,6 +54,7 @@ namespace Spartan
 	class ShaderLight;
 	class ShaderBuffered;
 	class Profiler;
+	class Threading;
 
 	namespace Math
 	{
@@ -194,9 +201,18 @@ namespace Spartan
 		void CreateSamplers();
 		void CreateRenderTextures();
 		void SetDefaultBuffer(uint32_t resolution_width, uint32_t resolution_height, const Math::Matrix& mMVP = Math::Matrix::Identity) const;
-		void RenderablesAcquire(const Variant& renderables);
-		void RenderablesSort(std::vector<Entity*>* renderables);
+		void RenderablesAcquire(const Variant& changes);
+		void RenderablesAdd(Entity* entity);
+		void RenderablesRemove(Entity* entity);
+		void RenderablesCull();
+		void RenderablesSort(RenderableType type);
+		// Writes the instances to the buffer (growing it if needed), returns null if there is nothing to draw
+		template<typename T>
+		RHI_VertexBuffer* InstanceBufferUpdate(std::shared_ptr<RHI_VertexBuffer>& buffer, const std::vector<T>& instances);
 		std::shared_ptr<RHI_RasterizerState>& GetRasterizerState(RHI_Cull_Mode cull_mode, RHI_Fill_Mode fill_mode);
+		// Splits [0, count) in chunks which record(cmd_list, start, end) records in parallel, each chunk into its own command list.
+		// The lists are appended to m_cmd_list in chunk order. Chunks start with whatever m_cmd_list has bound before the call.
+		void RecordParallel(uint32_t count, const std::function<void(RHI_CommandList*, uint32_t, uint32_t)>& record);
 
 		//= PASSES =========================================================================================================================================================
 		void Pass_Main();
@@ -303,6 +319,7 @@ namespace Spartan
 		std::shared_ptr<RHI_RasterizerState> m_rasterizer_cull_back_wireframe;
 		std::shared_ptr<RHI_RasterizerState> m_rasterizer_cull_front_wireframe;
 		std::shared_ptr<RHI_RasterizerState> m_rasterizer_cull_none_wireframe;
+		std::shared_ptr<RHI_RasterizerState> m_rasterizer_cull_back_solid_no_clip;
 		//=====================================================================
 
 		//= SAMPLERS ===========================================
@@ -344,6 +361,7 @@ namespace Spartan
 
 		//= CORE ================================================
 		Math::Rectangle m_quad;
+		std::vector<std::shared_ptr<RHI_CommandList>> m_cmd_lists_parallel;
 		std::shared_ptr<RHI_CommandList> m_cmd_list;
 		std::unique_ptr<Font> m_font;	
 		Math::Matrix m_view;
@@ -358,6 +376,7 @@ namespace Spartan
 		RendererDebug_Buffer m_debug_buffer = RendererDebug_None;
 		unsigned long m_flags = 0;
 		bool m_initialized = false;
+		Subscription m_subscription_world_submit = 0;
 		//=======================================================
 
 		//= RHI ============================================
@@ -367,6 +386,46 @@ namespace Spartan
 
 		//= ENTITIES/COMPONENTS ============================================
 		std::unordered_map<RenderableType, std::vector<Entity*>> m_entities;
+		// Entity -> index into m_entities, so that changes are constant time
+		std::unordered_map<RenderableType, std::unordered_map<Entity*, uint32_t>> m_entities_index;
+		// World space boxes of the opaque and transparent entities (same order as m_entities) and the indices that survive camera culling
+		std::unordered_map<RenderableType, Math::FrustumBoxes> m_entities_aabb;
+		// Transform version each packed box was computed with
+		std::unordered_map<RenderableType, std::vector<uint32_t>> m_entities_aabb_version;
+		std::unordered_map<RenderableType, std::vector<uint32_t>> m_entities_visible;
+		// Sort keys of the visible entities, rebuilt every frame
+		std::vector<Utility::Sorting::KeyIndex> m_draw_keys;
+		std::vector<Utility::Sorting::KeyIndex> m_draw_keys_scratch;
+		// Runs of draws which share geometry (and material for the G-buffer), drawn with one instanced draw
+		struct DrawBatch
+		{
+			Renderable* renderable;
+			uint32_t instance_offset;
+			uint32_t instance_count;
+		};
+		std::vector<DrawBatch> m_draw_batches;
+		std::vector<RHI_Instance_TransformHistory> m_instances_gbuffer;
+		std::vector<RHI_Instance_Transform> m_instances_depth;
+		// Commands read the instance buffers when submitted, so a buffer is written only once per pass. Every caster
+		// list of the light depth pass gets its own buffer as all the slices of a light are submitted together.
+		std::shared_ptr<RHI_VertexBuffer> m_instance_buffer_gbuffer;
+		std::vector<std::shared_ptr<RHI_VertexBuffer>> m_instance_buffers_depth;
+		uint32_t m_instance_buffers_depth_used = 0;
+		// Opaque indices that survive the culling of the light frustum being rendered, split by caster kind
+		std::vector<uint32_t> m_shadow_casters_visible;
+		std::vector<uint32_t> m_shadow_casters_static;
+		std::vector<uint32_t> m_shadow_casters_dynamic;
+		// Per opaque entity, casters that haven't moved for a while are static and live in the shadow map caches
+		struct ShadowCaster
+		{
+			uint32_t transform_version;
+			uint32_t still_frames;
+			uint64_t stamp; // changes whenever the caster could look different, the caches are signed with it
+		};
+		std::vector<ShadowCaster> m_shadow_casters;
+		uint64_t m_shadow_caster_stamp = 0;
+		// How long a caster has to stay still before it's cached as static
+		uint32_t m_shadow_caster_static_frames = 60;
 		float m_near_plane;
 		float m_far_plane;
 		std::shared_ptr<Camera> m_camera;
@@ -376,6 +435,7 @@ namespace Spartan
 
 		//= STATS/PROFILING ==============
 		Profiler* m_profiler	= nullptr;
+		Threading* m_threading	= nullptr;
 		uint64_t m_frame_num	= 0;
 		bool m_is_odd_frame		= false;
 		static bool m_is_rendering;
@@ -44,6 +44,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../World/Components/Light.h"
 #include "../World/Components/Camera.h"
 #include "../RHI/RHI_Texture2D.h"
+#include <cstring>
 //=========================================
 
 //= NAMESPACES ================
@@ -55,8 +56,80 @@ using namespace Helper;
 static const float GIZMO_MAX_SIZE = 5.0f;
 static const float GIZMO_MIN_SIZE = 0.1f;
 
+// World space box around the volume that a view projection can see
+static BoundingBox ClipVolumeBounds(const Matrix& view_projection)
+{
+	const auto view_projection_inverted = Matrix::Invert(view_projection);
+
+	BoundingBox box(Vector3::Infinity, Vector3::InfinityNeg);
+	for (uint32_t i = 0; i < 8; i++)
+	{
+		const Vector3 corner
+		(
+			(i & 1) ? 1.0f : -1.0f,
+			(i & 2) ? 1.0f : -1.0f,
+			(i & 4) ? 1.0f : 0.0f
+		);
+		const Vector3 corner_world = corner * view_projection_inverted;
+		box.Merge(BoundingBox(corner_world, corner_world));
+	}
+
+	return box;
+}
+
+// Spreads the bits of a caster stamp, so that the sum of many of them is unlikely to collide
+static uint64_t MixStamp(uint64_t stamp)
+{
+	stamp ^= stamp >> 33;
+	stamp *= 0xFF51AFD7ED558CCDull;
+	stamp ^= stamp >> 33;
+	return stamp;
+}
+
 namespace Spartan
 {
+	// Draws that can be instanced together
+	static bool SameGeometry(const Renderable* a, const Renderable* b)
+	{
+		return
+			a->GeometryModel_PtrRaw()	== b->GeometryModel_PtrRaw()	&&
+			a->GeometryIndexOffset()	== b->GeometryIndexOffset()		&&
+			a->GeometryIndexCount()		== b->GeometryIndexCount()		&&
+			a->GeometryVertexOffset()	== b->GeometryVertexOffset();
+	}
+
+	static bool SameGeometryAndMaterial(const Renderable* a, const Renderable* b)
+	{
+		return SameGeometry(a, b) && a->Material_PtrRaw() == b->Material_PtrRaw();
+	}
+
+	template<typename T>
+	RHI_VertexBuffer* Renderer::InstanceBufferUpdate(shared_ptr<RHI_VertexBuffer>& buffer, const vector<T>& instances)
+	{
+		if (instances.empty())
+			return nullptr;
+
+		const auto instance_count = static_cast<uint32_t>(instances.size());
+		if (!buffer)
+		{
+			buffer = make_shared<RHI_VertexBuffer>(m_rhi_device);
+		}
+		if (buffer->GetVertexCount() < instance_count)
+		{
+			// Grow geometrically, a scene that adds a few instances per frame shouldn't re-create it every frame
+			if (!buffer->CreateDynamic<T>(Max(instance_count + instance_count / 2, 64u)))
+				return nullptr;
+		}
+
+		auto data = buffer->Map();
+		if (!data)
+			return nullptr;
+		memcpy(data, instances.data(), sizeof(T) * instances.size());
+		buffer->Unmap();
+
+		return buffer.get();
+	}
+
 	void Renderer::Pass_Main()
 	{
 #ifdef API_GRAPHICS_VULKAN
@@ -95,7 +168,15 @@ namespace Spartan
 
 	void Renderer::Pass_LightDepth()
 	{
-		uint32_t light_directional_count = 0;
+		uint32_t light_directional_count	= 0;
+		m_directional_light_avg_dir			= Vector3::Zero;
+		m_instance_buffers_depth_used		= 0;
+
+		// Get opaque renderable entities
+		auto& entities				= m_entities[Renderable_ObjectOpaque];
+		const auto& entity_boxes	= m_entities_aabb[Renderable_ObjectOpaque];
+		const auto& camera_frustum	= m_camera->GetFrustum();
+		const auto copy_supported	= RHI_CommandList::IsCopySupported();
 
 		auto& light_entities = m_entities[Renderable_Light];
 		for (const auto& light_entity : light_entities)
@@ -111,49 +192,50 @@ namespace Spartan
 			if (!shadow_map)
 				continue;
 
-			// Get opaque renderable entities
-			auto& entities = m_entities[Renderable_ObjectOpaque];
 			if (entities.empty())
 				continue;
 
+			// Accumulate directional light direction
+			const auto is_directional = light->GetLightType() == LightType_Directional;
+			if (is_directional)
+			{
+				m_directional_light_avg_dir += light->GetDirection();
+				light_directional_count++;
+			}
+			// Skip point and spot lights which can't reach anything the camera sees
+			else if (camera_frustum.CheckSphere(light->GetTransform()->GetPosition(), light->GetRange()) == Outside)
+				continue;
+
 			// Begin command list
 			m_cmd_list->Begin("Pass_LightDepth");
 			m_cmd_list->SetShaderPixel(nullptr);
 			m_cmd_list->SetBlendState(m_blend_disabled);
 			m_cmd_list->SetDepthStencilState(m_depth_stencil_enabled);
-			m_cmd_list->SetRasterizerState(m_rasterizer_cull_back_solid);
+			// Directional casters between the light and the near plane are clamped onto it instead of being clipped
+			m_cmd_list->SetRasterizerState(is_directional ? m_rasterizer_cull_back_solid_no_clip : m_rasterizer_cull_back_solid);
 			m_cmd_list->SetPrimitiveTopology(PrimitiveTopology_TriangleList);
 			m_cmd_list->SetShaderVertex(m_v_depth);
 			m_cmd_list->SetInputLayout(m_v_depth->GetInputLayout());
 			m_cmd_list->SetViewport(shadow_map->GetViewport());
 
-			// Tracking
-			uint32_t currently_bound_geometry = 0;
-
-			for (uint32_t i = 0; i < light->GetShadowMap()->GetArraySize(); i++)
+			auto draw_casters = [this, &entities](const vector<uint32_t>& indices, const Matrix& light_view_projection)
 			{
-				auto cascade_depth_stencil = shadow_map->GetResource_DepthStencil(i);
-
-				m_cmd_list->Begin("Array_" + to_string(i + 1));
-				m_cmd_list->ClearDepthStencil(cascade_depth_stencil, Clear_Depth, GetClearDepth());
-				m_cmd_list->SetRenderTarget(nullptr, cascade_depth_stencil);
-
-				Matrix light_view_projection = light->GetViewMatrix(i) * light->GetProjectionMatrix(i);
-
-				for (const auto& entity : entities)
+				// Group the casters by geometry
+				m_draw_keys.clear();
+				for (const auto index : indices)
 				{
 					// Acquire renderable component
-					auto renderable = entity->GetRenderable_PtrRaw();
+					auto renderable = entities[index]->GetRenderable_PtrRaw();
 					if (!renderable)
 						continue;
 
 					// Acquire material
-					auto material = renderable->MaterialPtr();
+					auto material = renderable->Material_PtrRaw();
 					if (!material)
 						continue;
 
 					// Acquire geometry
-					auto model = renderable->GeometryModel();
+					auto model = renderable->GeometryModel_PtrRaw();
 					if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
 						continue;
 
@@ -165,28 +247,146 @@ namespace Spartan
 					if (material->GetColorAlbedo().w < 1.0f)
 						continue;
 
-					// Bind geometry
-					if (currently_bound_geometry != model->GetResourceId())
+					const auto key = (static_cast<uint64_t>(model->GetResourceId()) << 32) | renderable->GeometryIndexOffset();
+					m_draw_keys.emplace_back(Utility::Sorting::KeyIndex{ key, index });
+				}
+				Utility::Sorting::RadixSort(m_draw_keys, m_draw_keys_scratch);
+
+				// Casters with the same geometry are drawn with one instanced draw
+				m_draw_batches.clear();
+				m_instances_depth.clear();
+				for (const auto& draw : m_draw_keys)
+				{
+					Entity* entity	= entities[draw.index];
+					auto renderable	= entity->GetRenderable_PtrRaw();
+					if (m_draw_batches.empty() || !SameGeometry(m_draw_batches.back().renderable, renderable))
 					{
-						m_cmd_list->SetBufferIndex(model->GetIndexBuffer());
-						m_cmd_list->SetBufferVertex(model->GetVertexBuffer());
-						currently_bound_geometry = model->GetResourceId();
+						m_draw_batches.emplace_back(DrawBatch{ renderable, static_cast<uint32_t>(m_instances_depth.size()), 0 });
 					}
+					m_draw_batches.back().instance_count++;
+					m_instances_depth.emplace_back(RHI_Instance_Transform{ entity->GetTransform_PtrRaw()->GetMatrix() * light_view_projection });
+				}
 
-					// Accumulate directional light direction
-					if (light->GetLightType() == LightType_Directional)
+				if (m_instance_buffers_depth_used == m_instance_buffers_depth.size())
+				{
+					m_instance_buffers_depth.emplace_back();
+				}
+				const auto instance_buffer = InstanceBufferUpdate(m_instance_buffers_depth[m_instance_buffers_depth_used++], m_instances_depth);
+				if (!instance_buffer)
+					return;
+				m_cmd_list->SetBufferVertex(instance_buffer, 1);
+
+				// The batches are recorded in parallel, every chunk binds its own geometry
+				RecordParallel(static_cast<uint32_t>(m_draw_batches.size()), [this](RHI_CommandList* cmd_list, const uint32_t start, const uint32_t end)
+				{
+					uint32_t currently_bound_geometry = 0;
+					for (auto i = start; i < end; i++)
 					{
-						m_directional_light_avg_dir += light->GetDirection();
-						light_directional_count++;
+						const auto& batch	= m_draw_batches[i];
+						auto renderable		= batch.renderable;
+						auto model			= renderable->GeometryModel_PtrRaw();
+
+						// Bind geometry
+						if (currently_bound_geometry != model->GetResourceId())
+						{
+							cmd_list->SetBufferIndex(model->GetIndexBuffer());
+							cmd_list->SetBufferVertex(model->GetVertexBuffer());
+							currently_bound_geometry = model->GetResourceId();
+						}
+
+						cmd_list->DrawIndexedInstanced(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset(), batch.instance_count, batch.instance_offset);
 					}
+				});
+			};
+
+			for (uint32_t i = 0; i < light->GetShadowMap()->GetArraySize(); i++)
+			{
+				auto cascade_depth_stencil			= shadow_map->GetResource_DepthStencil(i);
+				auto cascade_depth_stencil_static	= light->GetShadowMapStatic()->GetResource_DepthStencil(i);
+				auto& cache							= light->GetShadowCache(i);
+
+				m_cmd_list->Begin("Array_" + to_string(i + 1));
 
-					// Update constant buffer
-					Transform* transform = entity->GetTransform_PtrRaw();
-					transform->UpdateConstantBufferLight(m_rhi_device, light_view_projection, i);
-					m_cmd_list->SetConstantBuffer(1, Buffer_VertexShader, transform->GetConstantBufferLight(i));
+				Matrix light_view_projection = light->GetViewMatrix(i) * light->GetProjectionMatrix(i);
 
-					m_cmd_list->DrawIndexed(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset());
+				// Skip cascades and cube faces which cover nothing the camera sees
+				const auto bounds = ClipVolumeBounds(light_view_projection);
+				if (camera_frustum.CheckCube(bounds.GetCenter(), bounds.GetExtents()) == Outside)
+				{
+					m_cmd_list->ClearDepthStencil(cascade_depth_stencil, Clear_Depth, GetClearDepth());
+					cache.has_dynamic = true;
+					m_cmd_list->End();
+					continue;
 				}
+
+				// Cull the casters against the light, casters of a directional light
+				// can be anywhere towards it as they are clamped onto the near plane
+				Frustum light_frustum;
+				light_frustum.Construct(light_view_projection);
+				if (is_directional)
+				{
+					light_frustum.Extrude(light->GetDirection() * -1.0f);
+				}
+				light_frustum.CheckCubes(entity_boxes, &m_shadow_casters_visible);
+
+				// Without texture copies the cache can't be composited, so everything is drawn every frame
+				if (!copy_supported)
+				{
+					m_cmd_list->ClearDepthStencil(cascade_depth_stencil, Clear_Depth, GetClearDepth());
+					m_cmd_list->SetRenderTarget(nullptr, cascade_depth_stencil);
+					draw_casters(m_shadow_casters_visible, light_view_projection);
+					cache.has_dynamic = true;
+					m_cmd_list->End();
+					continue;
+				}
+
+				// The cache only depends on the static casters this slice covers, so it's
+				// signed with them and anything that happens elsewhere leaves it untouched
+				m_shadow_casters_static.clear();
+				m_shadow_casters_dynamic.clear();
+				uint64_t caster_signature = 1;
+				for (const auto index : m_shadow_casters_visible)
+				{
+					const auto& caster = m_shadow_casters[index];
+					if (caster.still_frames < m_shadow_caster_static_frames)
+					{
+						m_shadow_casters_dynamic.emplace_back(index);
+					}
+					else
+					{
+						m_shadow_casters_static.emplace_back(index);
+						caster_signature += MixStamp(caster.stamp); // order independent
+					}
+				}
+
+				// Static casters are only drawn when the light or one of the casters it covers has changed
+				const auto cache_stale = cache.caster_signature != caster_signature || cache.view_projection != light_view_projection;
+				if (cache_stale)
+				{
+					m_cmd_list->ClearDepthStencil(cascade_depth_stencil_static, Clear_Depth, GetClearDepth());
+					m_cmd_list->SetRenderTarget(nullptr, cascade_depth_stencil_static);
+					draw_casters(m_shadow_casters_static, light_view_projection);
+
+					cache.view_projection	= light_view_projection;
+					cache.caster_signature	= caster_signature;
+				}
+
+				// Start from the cache, unless the shadow map already holds exactly that
+				if (cache_stale || cache.has_dynamic || !m_shadow_casters_dynamic.empty())
+				{
+					m_cmd_list->SetRenderTarget(nullptr, nullptr);
+					m_cmd_list->CopyTexture(light->GetShadowMapStatic().get(), shadow_map.get(), i);
+					cache.has_dynamic = false;
+				}
+
+				// Dynamic casters are drawn every frame
+				if (!m_shadow_casters_dynamic.empty())
+				{
+					m_cmd_list->SetRenderTarget(nullptr, cascade_depth_stencil);
+					draw_casters(m_shadow_casters_dynamic, light_view_projection);
+					cache.has_dynamic = true;
+				}
+
 				m_cmd_list->End(); // end of cascade
 			}
 			m_cmd_list->End();
@@ -194,7 +394,10 @@ namespace Spartan
 		}
 
 		// Compute average directional light direction
-		m_directional_light_avg_dir /= static_cast<float>(light_directional_count);
+		if (light_directional_count != 0)
+		{
+			m_directional_light_avg_dir /= static_cast<float>(light_directional_count);
+		}
 	}
 
 	void Renderer::Pass_GBuffer()
@@ -221,7 +424,6 @@ namespace Spartan
 
 		// Prepare resources
 		SetDefaultBuffer(static_cast<uint32_t>(m_resolution.x), static_cast<uint32_t>(m_resolution.y));
-		vector<void*> textures(8);
 		vector<void*> render_targets
 		{
 			m_g_buffer_albedo->GetResource_RenderTarget(),
@@ -244,85 +446,113 @@ namespace Spartan
 		m_cmd_list->SetConstantBuffer(0, Buffer_Global, m_buffer_global);
 		m_cmd_list->SetSampler(0, m_sampler_anisotropic_wrap);	
 		
-		// Variables that help reduce state changes
-		uint32_t currently_bound_geometry	= 0;
-		uint32_t currently_bound_shader		= 0;
-		uint32_t currently_bound_material	= 0;
-
-		for (auto entity : m_entities[Renderable_ObjectOpaque])
+		// Consecutive draws of the same geometry with the same material are drawn with one instanced
+		// draw, the visible entities are sorted by shader, material and geometry so they end up together
+		m_draw_batches.clear();
+		m_instances_gbuffer.clear();
+		const auto& entities = m_entities[Renderable_ObjectOpaque];
+		for (const auto index : m_entities_visible[Renderable_ObjectOpaque])
 		{
+			auto entity = entities[index];
+
 			// Get renderable and material
 			auto renderable = entity->GetRenderable_PtrRaw();
-			auto material	= renderable ? renderable->MaterialPtr().get() : nullptr;
+			auto material	= renderable ? renderable->Material_PtrRaw() : nullptr;
 
 			if (!renderable || !material)
 				continue;
 
-			// Get shader and geometry
-			auto shader = material->GetShader();
-			auto model	= renderable->GeometryModel();
-
 			// Validate shader
+			const auto& shader = material->GetShader();
 			if (!shader || shader->GetCompilationState() != Shader_Compiled)
 				continue;
 
 			// Validate geometry
+			auto model = renderable->GeometryModel_PtrRaw();
 			if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
 				continue;
 
-			// Skip objects outside of the view frustum
-			if (!m_camera->IsInViewFrustrum(renderable))
-				continue;
-
-			// Set face culling (changes only if required)
-			m_cmd_list->SetRasterizerState(GetRasterizerState(material->GetCullMode(), Fill_Solid));
-
-			// Bind geometry
-			if (currently_bound_geometry != model->GetResourceId())
+			if (m_draw_batches.empty() || !SameGeometryAndMaterial(m_draw_batches.back().renderable, renderable))
 			{
-				m_cmd_list->SetBufferIndex(model->GetIndexBuffer());
-				m_cmd_list->SetBufferVertex(model->GetVertexBuffer());
-				currently_bound_geometry = model->GetResourceId();
+				m_draw_batches.emplace_back(DrawBatch{ renderable, static_cast<uint32_t>(m_instances_gbuffer.size()), 0 });
 			}
+			m_draw_batches.back().instance_count++;
 
-			// Bind shader
-			if (currently_bound_shader != shader->RHI_GetID())
-			{
-				m_cmd_list->SetShaderPixel(static_pointer_cast<RHI_Shader>(shader));
-				currently_bound_shader = shader->RHI_GetID();
-			}
+			m_instances_gbuffer.emplace_back();
+			entity->GetTransform_PtrRaw()->UpdateInstance(m_view_projection, &m_instances_gbuffer.back());
+		}
+
+		// The instance data of the whole pass is written at once, each draw reads it from its instance offset
+		if (const auto instance_buffer = InstanceBufferUpdate(m_instance_buffer_gbuffer, m_instances_gbuffer))
+		{
+			m_cmd_list->SetBufferVertex(instance_buffer, 1);
+		}
+		else
+		{
+			m_draw_batches.clear();
+		}
 
-			// Bind material
-			if (currently_bound_material != material->GetResourceId())
+		// The batches are recorded in parallel, every chunk binds what it needs on its own
+		RecordParallel(static_cast<uint32_t>(m_draw_batches.size()), [this](RHI_CommandList* cmd_list, const uint32_t start, const uint32_t end)
+		{
+			// Variables that help reduce state changes
+			uint32_t currently_bound_geometry	= 0;
+			uint32_t currently_bound_shader		= 0;
+			uint32_t currently_bound_material	= 0;
+			vector<void*> textures(8);
+
+			for (auto i = start; i < end; i++)
 			{
-				// Bind material textures
-				textures[0] = material->GetTextureShaderResourceByType(TextureType_Albedo);
-				textures[1] = material->GetTextureShaderResourceByType(TextureType_Roughness);
-				textures[2] = material->GetTextureShaderResourceByType(TextureType_Metallic);
-				textures[3] = material->GetTextureShaderResourceByType(TextureType_Normal);
-				textures[4] = material->GetTextureShaderResourceByType(TextureType_Height);
-				textures[5] = material->GetTextureShaderResourceByType(TextureType_Occlusion);
-				textures[6] = material->GetTextureShaderResourceByType(TextureType_Emission);
-				textures[7] = material->GetTextureShaderResourceByType(TextureType_Mask);
-				m_cmd_list->SetTextures(0, textures);
-
-				// Bind material buffer
-				material->UpdateConstantBuffer();
-				m_cmd_list->SetConstantBuffer(1, Buffer_PixelShader, material->GetConstantBuffer());
-
-				currently_bound_material = material->GetResourceId();
-			}
+				const auto& batch	= m_draw_batches[i];
+				auto renderable		= batch.renderable;
+				auto material		= renderable->Material_PtrRaw();
+				auto& shader		= material->GetShader();
+				auto model			= renderable->GeometryModel_PtrRaw();
 
-			// Bind object buffer
-			Transform* transform = entity->GetTransform_PtrRaw();
-			transform->UpdateConstantBuffer(m_rhi_device, m_view_projection);
-			m_cmd_list->SetConstantBuffer(2, Buffer_VertexShader, transform->GetConstantBuffer());
+				// Set face culling (changes only if required)
+				cmd_list->SetRasterizerState(GetRasterizerState(material->GetCullMode(), Fill_Solid));
 
-			// Render	
-			m_cmd_list->DrawIndexed(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset());
-			m_profiler->m_renderer_meshes_rendered++;
+				// Bind geometry
+				if (currently_bound_geometry != model->GetResourceId())
+				{
+					cmd_list->SetBufferIndex(model->GetIndexBuffer());
+					cmd_list->SetBufferVertex(model->GetVertexBuffer());
+					currently_bound_geometry = model->GetResourceId();
+				}
 
-		} // ENTITY/MESH ITERATION
+				// Bind shader
+				if (currently_bound_shader != shader->RHI_GetID())
+				{
+					cmd_list->SetShaderPixel(shader.get());
+					currently_bound_shader = shader->RHI_GetID();
+				}
+
+				// Bind material
+				if (currently_bound_material != material->GetResourceId())
+				{
+					// Bind material textures
+					textures[0] = material->GetTextureShaderResourceByType(TextureType_Albedo);
+					textures[1] = material->GetTextureShaderResourceByType(TextureType_Roughness);
+					textures[2] = material->GetTextureShaderResourceByType(TextureType_Metallic);
+					textures[3] = material->GetTextureShaderResourceByType(TextureType_Normal);
+					textures[4] = material->GetTextureShaderResourceByType(TextureType_Height);
+					textures[5] = material->GetTextureShaderResourceByType(TextureType_Occlusion);
+					textures[6] = material->GetTextureShaderResourceByType(TextureType_Emission);
+					textures[7] = material->GetTextureShaderResourceByType(TextureType_Mask);
+					cmd_list->SetTextures(0, textures);
+
+					// Bind material buffer
+					cmd_list->SetConstantBufferData(1, Buffer_PixelShader, material->GetConstantBufferData());
+
+					currently_bound_material = material->GetResourceId();
+				}
+
+				// Render
+				cmd_list->DrawIndexedInstanced(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset(), batch.instance_count, batch.instance_offset);
+
+			} // BATCH ITERATION
+		});
+		m_profiler->m_renderer_meshes_rendered += static_cast<uint32_t>(m_instances_gbuffer.size());
 
 		m_cmd_list->End();
 		m_cmd_list->Submit();
@@ -447,8 +677,11 @@ namespace Spartan
 		m_cmd_list->SetInputLayout(m_vps_transparent->GetInputLayout());
 		m_cmd_list->SetShaderPixel(m_vps_transparent);
 
-		for (auto& entity : entities_transparent)
+		// Only the entities that survived frustum culling
+		for (const auto index : m_entities_visible[Renderable_ObjectTransparent])
 		{
+			auto entity = entities_transparent[index];
+
 			// Get renderable and material
 			auto renderable	= entity->GetRenderable_PtrRaw();
 			auto material	= renderable ? renderable->MaterialPtr().get() : nullptr;
@@ -461,17 +694,13 @@ namespace Spartan
 			if (!model || !model->GetVertexBuffer() || !model->GetIndexBuffer())
 				continue;
 
-			// Skip objects outside of the view frustum
-			if (!m_camera->IsInViewFrustrum(renderable))
-				continue;
-
 			// Set the following per object
 			m_cmd_list->SetRasterizerState(GetRasterizerState(material->GetCullMode(), Fill_Solid));
 			m_cmd_list->SetBufferIndex(model->GetIndexBuffer());
 			m_cmd_list->SetBufferVertex(model->GetVertexBuffer());
 
-			// Constant buffer - TODO: Make per object
-			auto buffer = Struct_Transparency
+			// Constant buffer
+			const auto buffer = Struct_Transparency
 			(
 				entity->GetTransform_PtrRaw()->GetMatrix(),
 				m_view,
@@ -481,8 +710,7 @@ namespace Spartan
 				m_directional_light_avg_dir,
 				material->GetRoughnessMultiplier()
 			);
-			m_vps_transparent->UpdateBuffer(&buffer);
-			m_cmd_list->SetConstantBuffer(1, Buffer_Global, m_vps_transparent->GetConstantBuffer());
+			m_cmd_list->SetConstantBufferData(1, Buffer_Global, buffer);
 			m_cmd_list->DrawIndexed(renderable->GeometryIndexCount(), renderable->GeometryIndexOffset(), renderable->GeometryVertexOffset());
 
 			m_profiler->m_renderer_meshes_rendered++;
@@ -0,0 +1,163 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =========================
+#include <array>
+#include <vector>
+#include "../../Math/MathHelper.h"
+#include "../../Threading/Threading.h"
+//====================================
+
+namespace Spartan::Utility::Sorting
+{
+	// A sort key and the index of what it sorts
+	struct KeyIndex
+	{
+		uint64_t key;
+		uint32_t index;
+	};
+
+	// Stable least significant digit radix sort, 8 bits per pass. Items move back and forth between the two
+	// vectors and the result ends up in items. Large inputs are split into chunks which count and scatter in
+	// parallel, the chunks keep their order so the sort stays stable.
+	inline void RadixSort(std::vector<KeyIndex>& items, std::vector<KeyIndex>& scratch, Threading* threading = nullptr)
+	{
+		const auto count = static_cast<uint32_t>(items.size());
+		if (count < 2)
+			return;
+
+		const uint32_t digit_count	= 8;
+		const uint32_t bucket_count	= 256;
+		const uint32_t chunk_min	= 4096;
+		const uint32_t chunk_count	= (threading && count >= chunk_min * 2) ? Math::Helper::Min<uint32_t>(count / chunk_min, 16) : 1;
+		const uint32_t chunk_size	= (count + chunk_count - 1) / chunk_count;
+
+		auto for_each_chunk = [threading, chunk_count](auto&& function)
+		{
+			if (chunk_count > 1)
+			{
+				threading->ParallelFor(chunk_count, 1, function);
+			}
+			else
+			{
+				function(0);
+			}
+		};
+
+		// The histograms of all the digits are counted in one read, per chunk and then summed
+		std::vector<std::array<std::array<uint32_t, bucket_count>, digit_count>> histograms(chunk_count);
+		KeyIndex* source = items.data();
+		for_each_chunk([&histograms, source, chunk_size, count](const uint32_t chunk)
+		{
+			auto& histogram		= histograms[chunk];
+			const auto start	= chunk * chunk_size;
+			const auto end		= Math::Helper::Min(start + chunk_size, count);
+			for (auto& digit : histogram)
+			{
+				digit.fill(0);
+			}
+			for (auto i = start; i < end; i++)
+			{
+				const auto key = source[i].key;
+				for (uint32_t digit = 0; digit < digit_count; digit++)
+				{
+					histogram[digit][(key >> (digit * 8)) & 0xFF]++;
+				}
+			}
+		});
+		auto totals = histograms[0];
+		for (uint32_t chunk = 1; chunk < chunk_count; chunk++)
+		{
+			for (uint32_t digit = 0; digit < digit_count; digit++)
+			{
+				for (uint32_t bucket = 0; bucket < bucket_count; bucket++)
+				{
+					totals[digit][bucket] += histograms[chunk][digit][bucket];
+				}
+			}
+		}
+
+		// Per chunk write offsets of the current pass
+		std::vector<std::array<uint32_t, bucket_count>> offsets(chunk_count);
+
+		scratch.resize(count);
+		KeyIndex* destination = scratch.data();
+		for (uint32_t digit = 0; digit < digit_count; digit++)
+		{
+			// Skip the pass when every key has the same value for this digit
+			if (totals[digit][(source[0].key >> (digit * 8)) & 0xFF] == count)
+				continue;
+
+			// Every pass reorders the items, so after the first one the chunks have to count this digit again
+			if (chunk_count == 1)
+			{
+				offsets[0] = totals[digit];
+			}
+			else
+			{
+				for_each_chunk([&offsets, source, digit, chunk_size, count](const uint32_t chunk)
+				{
+					auto& histogram		= offsets[chunk];
+					const auto start	= chunk * chunk_size;
+					const auto end		= Math::Helper::Min(start + chunk_size, count);
+					histogram.fill(0);
+					for (auto i = start; i < end; i++)
+					{
+						histogram[(source[i].key >> (digit * 8)) & 0xFF]++;
+					}
+				});
+			}
+
+			// Turn the counts into write offsets, bucket major so that the chunks keep their order
+			uint32_t offset = 0;
+			for (uint32_t bucket = 0; bucket < bucket_count; bucket++)
+			{
+				for (auto& histogram : offsets)
+				{
+					const auto bucket_size	= histogram[bucket];
+					histogram[bucket]		= offset;
+					offset					+= bucket_size;
+				}
+			}
+
+			for_each_chunk([&offsets, source, destination, digit, chunk_size, count](const uint32_t chunk)
+			{
+				auto& chunk_offsets	= offsets[chunk];
+				const auto start	= chunk * chunk_size;
+				const auto end		= Math::Helper::Min(start + chunk_size, count);
+				for (auto i = start; i < end; i++)
+				{
+					destination[chunk_offsets[(source[i].key >> (digit * 8)) & 0xFF]++] = source[i];
+				}
+			});
+
+			std::swap(source, destination);
+		}
+
+		// An odd number of passes leaves the result in the scratch buffer
+		if (source != items.data())
+		{
+			items.swap(scratch);
+		}
+	}
+}
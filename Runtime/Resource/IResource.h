@@ -22,7 +22,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES ========================
+#include <atomic>
 #include <memory>
+#include <vector>
 #include "../Core/Context.h"
 #include "../FileSystem/FileSystem.h"
 #include "../Logging/Log.h"
@@ -50,6 +52,7 @@ namespace Spartan
 	{
 		LoadState_Idle,
 		LoadState_Started,
+		LoadState_Decoded,	// waiting to be finalized
 		LoadState_Completed,
 		LoadState_Failed
 	};
@@ -74,12 +77,21 @@ namespace Spartan
 		std::string GetResourceDirectory() const				{ return FileSystem::GetDirectoryFromFilePath(m_resource_file_path); }
 		virtual uint32_t GetMemoryUsage()					{ return static_cast<uint32_t>(sizeof(*this)); }
 		LoadState GetLoadState() const							{ return m_load_state; }
+		void SetLoadState(const LoadState state)				{ m_load_state = state; }
 		//======================================================================================================================================
 
-		//= IO =================================================================
+		//= IO =======================================================================================
 		virtual bool SaveToFile(const std::string& file_path)	{ return true; }
 		virtual bool LoadFromFile(const std::string& file_path)	{ return true; }
-		//======================================================================
+
+		// Asynchronous loads are split in two. Decoding runs on the job system, finalizing (e.g. creating
+		// GPU resources) runs on the thread which ticks the engine. By default, decoding does all of it.
+		virtual bool LoadFromFile_Decode(const std::string& file_path)	{ return LoadFromFile(file_path); }
+		virtual bool LoadFromFile_Finalize()							{ return true; }
+
+		// Decodes a file which was already read into memory (e.g. by the streaming subsystem), returns false if the resource can't
+		virtual bool LoadFromMemory_Decode(const std::string& file_path, std::vector<std::byte>&& data) { return false; }
+		//==============================================================================================
 
 		//= TYPE ===================================
 		template <typename T>
@@ -92,7 +104,7 @@ namespace Spartan
 
 	protected:
 		Resource_Type m_resource_type	= Resource_Unknown;
-		LoadState m_load_state			= LoadState_Idle;
+		std::atomic<LoadState> m_load_state	= LoadState_Idle;
 		Context* m_context				= nullptr;
 
 	private:
@@ -46,7 +46,6 @@ namespace _ImagImporter
 		uint32_t height		= 0;
 		uint32_t channels	= 0;
 		vector<byte>* data		= nullptr;
-		bool done				= false;
 
 		RescaleJob(const uint32_t width, const uint32_t height, const uint32_t channels)
 		{
@@ -212,34 +211,16 @@ namespace Spartan
 		}
 
 		// Parallelize mipmap generation using multiple threads (because FreeImage_Rescale() using FILTER_LANCZOS3 is expensive)
-		auto threading = m_context->GetSubsystem<Threading>();
-		for (auto& job : jobs)
+		m_context->GetSubsystem<Threading>()->ParallelFor(static_cast<uint32_t>(jobs.size()), 1, [this, &jobs, &bitmap](const uint32_t i)
 		{
-			threading->AddTask([this, &job, &bitmap]()
+			auto& job = jobs[i];
+			const auto bitmap_scaled = FreeImage_Rescale(bitmap, job.width, job.height, _ImagImporter::rescale_filter);
+			if (!GetBitsFromFibitmap(job.data, bitmap_scaled, job.width, job.height, job.channels))
 			{
-				const auto bitmap_scaled = FreeImage_Rescale(bitmap, job.width, job.height, _ImagImporter::rescale_filter);
-				if (!GetBitsFromFibitmap(job.data, bitmap_scaled, job.width, job.height, job.channels))
-				{
-					LOGF_ERROR("Failed to create mip level %dx%d", job.width, job.height);
-				}
-				FreeImage_Unload(bitmap_scaled);
-				job.done = true;
-			});
-		}
-
-		// Wait until all mipmaps have been generated
-		auto ready = false;
-		while (!ready)
-		{
-			ready = true;
-			for (const auto& job : jobs)
-			{
-				if (!job.done)
-				{
-					ready = false;
-				}
+				LOGF_ERROR("Failed to create mip level %dx%d", job.width, job.height);
 			}
-		}
+			FreeImage_Unload(bitmap_scaled);
+		});
 	}
 
 	uint32_t ImageImporter::ComputeChannelCount(FIBITMAP* bitmap)
@@ -71,7 +71,7 @@ namespace Spartan
 	ModelImporter::ModelImporter(Context* context)
 	{
 		m_context	= context;
-		m_world		= context->GetSubsystem<World>().get();
+		m_world		= context->GetSubsystem<World>();
 
 		// Get version
 		const int major	= aiGetVersionMajor();
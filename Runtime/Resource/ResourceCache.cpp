@@ -21,13 +21,17 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES ======================
 #include "ResourceCache.h"
+#include <algorithm>
 #include "ProgressReport.h"
 #include "../World/World.h"
 #include "../World/Entity.h"
+#include "../IO/Archive.h"
 #include "../IO/FileStream.h"
+#include "../IO/Streaming.h"
 #include "../Core/EventSystem.h"
 #include "../RHI/RHI_Texture2D.h"
 #include "../RHI/RHI_TextureCube.h"
+#include "../Threading/Threading.h"
 //=================================
 
 //= NAMESPACES ================
@@ -56,13 +60,25 @@ namespace Spartan
 		// Subscribe to events
 		SUBSCRIBE_TO_EVENT(Event_World_Save,	EVENT_HANDLER(SaveResourcesToFiles));
 		SUBSCRIBE_TO_EVENT(Event_World_Load,	EVENT_HANDLER(LoadResourcesFromFiles));
-		SUBSCRIBE_TO_EVENT(Event_World_Unload,	EVENT_HANDLER(Clear));
+		m_subscription_world_unload = SUBSCRIBE_TO_EVENT(Event_World_Unload, EVENT_HANDLER(Clear));
 	}
 
 	ResourceCache::~ResourceCache()
 	{
 		// Unsubscribe from event
-		UNSUBSCRIBE_FROM_EVENT(Event_World_Unload, EVENT_HANDLER(Clear));
+		UNSUBSCRIBE_FROM_EVENT(Event_World_Unload, m_subscription_world_unload);
+
+		// The renderer is gone, so loads which haven't been finalized can't be
+		{
+			lock_guard<mutex> lock(m_loads_decoded_mutex);
+			for (const auto& load : m_loads_decoded)
+			{
+				load->resource->SetLoadState(LoadState_Failed);
+				load->counter.Decrement();
+			}
+			m_loads_decoded.clear();
+		}
+
 		Clear();
 	}
 
@@ -72,9 +88,20 @@ namespace Spartan
 		m_importer_image	= make_shared<ImageImporter>(m_context);
 		m_importer_model	= make_shared<ModelImporter>(m_context);
 		m_importer_font		= make_shared<FontImporter>(m_context);
+
+		// Loads are finalized by whichever thread ticks the engine, which is the one initializing it
+		m_threading				= m_context->GetSubsystem<Threading>();
+		m_streaming				= m_context->GetSubsystem<Streaming>();
+		m_finalize_thread_id	= this_thread::get_id();
+
 		return true;
 	}
 
+	void ResourceCache::Tick()
+	{
+		LoadFinalize();
+	}
+
 	bool ResourceCache::IsCached(const string& resource_name, const Resource_Type resource_type /*= Resource_Unknown*/)
 	{
 		if (resource_name == NOT_ASSIGNED)
@@ -83,40 +110,53 @@ namespace Spartan
 			return false;
 		}
 
-		for (const auto& resource : m_resource_groups[resource_type])
-		{
-			if (resource_name == resource->GetResourceName())
-				return true;
-		}
+		return GetByName(resource_name, resource_type) != nullptr;
+	}
+
+	shared_ptr<IResource> ResourceCache::GetByName(const string& name, const Resource_Type type)
+	{
+		lock_guard<mutex> lock(m_mutex);
+
+		const auto group = m_resource_groups.find(type);
+		if (group == m_resource_groups.end())
+			return nullptr;
 
-		return false;
+		const auto it = group->second.by_name.find(name);
+		return it != group->second.by_name.end() ? group->second.resources[it->second] : nullptr;
 	}
 
-	shared_ptr<IResource>& ResourceCache::GetByName(const string& name, const Resource_Type type)
+	shared_ptr<IResource> ResourceCache::GetByPath(const string& path, const Resource_Type type)
 	{
-		for (auto& resource : m_resource_groups[type])
-		{
-			if (name == resource->GetResourceName())
-				return resource;
-		}
+		lock_guard<mutex> lock(m_mutex);
+
+		const auto group = m_resource_groups.find(type);
+		if (group == m_resource_groups.end())
+			return nullptr;
 
-		return m_empty_resource;
+		const auto it = group->second.by_path.find(path);
+		return it != group->second.by_path.end() ? group->second.resources[it->second] : nullptr;
 	}
 
 	vector<shared_ptr<IResource>> ResourceCache::GetByType(const Resource_Type type /*= Resource_Unknown*/)
 	{
+		lock_guard<mutex> lock(m_mutex);
+
 		vector<shared_ptr<IResource>> resources;
 
 		if (type == Resource_Unknown)
 		{
 			for (const auto& resource_group : m_resource_groups)
 			{
-				resources.insert(resources.end(), resource_group.second.begin(), resource_group.second.end());
+				resources.insert(resources.end(), resource_group.second.resources.begin(), resource_group.second.resources.end());
 			}
 		}
 		else
 		{
-			resources = m_resource_groups[type];
+			const auto group = m_resource_groups.find(type);
+			if (group != m_resource_groups.end())
+			{
+				resources = group->second.resources;
+			}
 		}
 
 		return resources;
@@ -126,25 +166,12 @@ namespace Spartan
 	{
 		uint32_t size = 0;
 
-		if (type = Resource_Unknown)
+		for (const auto& resource : GetByType(type))
 		{
-			for (const auto& group : m_resource_groups)
-			{
-				for (const auto& resource : group.second)
-				{
-					if (!resource)
-						continue;
+			if (!resource)
+				continue;
 
-					size += resource->GetMemoryUsage();
-				}
-			}
-		}
-		else
-		{
-			for (const auto& resource : m_resource_groups[type])
-			{
-				size += resource->GetMemoryUsage();
-			}
+			size += resource->GetMemoryUsage();
 		}
 
 		return size;
@@ -173,22 +200,36 @@ namespace Spartan
 		file->Write(resource_count);
 
 		// Save all the currently used resources to disk
-		for (const auto& resource_group : m_resource_groups)
+		for (const auto& resource : GetByType())
 		{
-			for (const auto& resource : resource_group.second)
-			{
-				if (!resource->HasFilePath())
-					continue;
+			if (!resource->HasFilePath())
+				continue;
+
+			// Save file path
+			file->Write(resource->GetResourceFilePath());
+			// Save type
+			file->Write(static_cast<uint32_t>(resource->GetResourceType()));
+			// Save resource (to a dedicated file), which can change its file path
+			const auto name = resource->GetResourceName();
+			const auto path = resource->GetResourceFilePath();
+			resource->SaveToFile(path);
+			Reindex(resource, name, path);
+
+			// Update progress
+			ProgressReport::Get().IncrementJobsDone(g_progress_resource_cache);
+		}
+		file->Close();
 
-				// Save file path
-				file->Write(resource->GetResourceFilePath());
-				// Save type
-				file->Write(static_cast<uint32_t>(resource->GetResourceType()));
-				// Save resource (to a dedicated file)
-				resource->SaveToFile(resource->GetResourceFilePath());
+		// The world was loaded from an archive, which would shadow the files that were just saved, so pack them again
+		if (!m_archive_path.empty())
+		{
+			const auto archive_path = m_archive_path;
+			Archive::Unmount(archive_path);
+			m_archive_path.clear();
 
-				// Update progress
-				ProgressReport::Get().IncrementJobsDone(g_progress_resource_cache);
+			if (PackResources(archive_path, true) && Archive::Mount(archive_path))
+			{
+				m_archive_path = archive_path;
 			}
 		}
 
@@ -198,6 +239,13 @@ namespace Spartan
 
 	void ResourceCache::LoadResourcesFromFiles()
 	{
+		// Mount the world's archive (if it has been packed), the resource list is in it too
+		const auto archive_path = GetProjectDirectoryAbsolute() + m_context->GetSubsystem<World>()->GetName() + ".pak";
+		if (FileSystem::FileExists(archive_path) && Archive::Mount(archive_path))
+		{
+			m_archive_path = archive_path;
+		}
+
 		// Open resource list file
 		auto file_path = GetProjectDirectoryAbsolute() + m_context->GetSubsystem<World>()->GetName() + "_resources.dat";
 		auto file = make_unique<FileStream>(file_path, FileStream_Read);
@@ -207,6 +255,9 @@ namespace Spartan
 		// Load resource count
 		auto resource_count = file->ReadAs<uint32_t>();
 
+		// Load them all in parallel, then wait for all of them
+		vector<ResourceHandle<IResource>> loads;
+		loads.reserve(resource_count);
 		for (uint32_t i = 0; i < resource_count; i++)
 		{
 			// Load resource file path
@@ -218,22 +269,379 @@ namespace Spartan
 			switch (type)
 			{
 			case Resource_Model:
-				Load<Model>(file_path);
+				loads.emplace_back(LoadAsync<Model>(file_path, Streaming_Visible));
 				break;
 			case Resource_Material:
-				Load<Material>(file_path);
+				loads.emplace_back(LoadAsync<Material>(file_path, Streaming_Visible));
 				break;
 			case Resource_Texture:
-				Load<RHI_Texture>(file_path);
+				loads.emplace_back(LoadAsync<RHI_Texture>(file_path, Streaming_Visible));
 				break;
 			case Resource_Texture2d:
-				Load<RHI_Texture2D>(file_path);
+				loads.emplace_back(LoadAsync<RHI_Texture2D>(file_path, Streaming_Visible));
 				break;
 			case Resource_TextureCube:
-				Load<RHI_TextureCube>(file_path);
+				loads.emplace_back(LoadAsync<RHI_TextureCube>(file_path, Streaming_Visible));
 				break;
 			}
 		}
+
+		for (const auto& load : loads)
+		{
+			load.Wait();
+		}
+	}
+
+	bool ResourceCache::SaveResourcesToArchive(const bool compress /*= true*/)
+	{
+		const auto world_path = GetProjectDirectoryAbsolute() + m_context->GetSubsystem<World>()->GetName();
+		const auto archive_path = world_path + ".pak";
+
+		// The archive is about to be overwritten, so nothing can be reading from it
+		Archive::Unmount(archive_path);
+		if (m_archive_path == archive_path)
+		{
+			m_archive_path.clear();
+		}
+
+		// Pack what's on disk, so save it first
+		SaveResourcesToFiles();
+
+		return PackResources(archive_path, compress);
+	}
+
+	bool ResourceCache::PackResources(const string& archive_path, const bool compress)
+	{
+		vector<string> file_paths = { GetProjectDirectoryAbsolute() + m_context->GetSubsystem<World>()->GetName() + "_resources.dat" };
+		for (const auto& resource : GetByType())
+		{
+			if (resource->HasFilePath())
+			{
+				file_paths.emplace_back(resource->GetResourceFilePath());
+			}
+		}
+
+		return Archive::Create(archive_path, file_paths, compress);
+	}
+
+	void ResourceCache::Clear()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_resource_groups.clear();
+		}
+
+		if (!m_archive_path.empty())
+		{
+			Archive::Unmount(m_archive_path);
+			m_archive_path.clear();
+		}
+	}
+
+	void ResourceCache::Wait(const ResourceLoad& load)
+	{
+		// Something is waiting for it now
+		if (m_streaming && load.read != 0)
+		{
+			m_streaming->SetPriority(load.read, Streaming_Critical);
+		}
+
+		// The thread which finalizes loads can't wait for itself, so it keeps finalizing while it waits
+		const auto finalizes = IsFinalizeThread();
+		while (!load.counter.IsDone())
+		{
+			if (finalizes)
+			{
+				LoadFinalize();
+				if (load.counter.IsDone())
+					break;
+			}
+
+			if (!m_threading || !m_threading->TryExecute())
+			{
+				this_thread::yield();
+			}
+		}
+	}
+
+	shared_ptr<IResource> ResourceCache::Insert(const shared_ptr<IResource>& resource)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		return Insert(m_resource_groups[resource->GetResourceType()], resource);
+	}
+
+	shared_ptr<IResource> ResourceCache::Insert(ResourceGroup& group, const shared_ptr<IResource>& resource)
+	{
+		// If the resource is already cached, return the existing one instead
+		const auto index = static_cast<uint32_t>(group.resources.size());
+		const auto it = group.by_name.emplace(resource->GetResourceName(), index);
+		if (!it.second)
+			return group.resources[it.first->second];
+
+		group.resources.emplace_back(resource);
+		if (resource->HasFilePath())
+		{
+			group.by_path.emplace(resource->GetResourceFilePath(), index);
+		}
+
+		return resource;
+	}
+
+	void ResourceCache::Reindex(const shared_ptr<IResource>& resource, const string& name_previous, const string& path_previous)
+	{
+		if (resource->GetResourceName() == name_previous && resource->GetResourceFilePath() == path_previous)
+			return;
+
+		lock_guard<mutex> lock(m_mutex);
+
+		const auto group_it = m_resource_groups.find(resource->GetResourceType());
+		if (group_it == m_resource_groups.end())
+			return;
+
+		// Only the entries of this resource are moved, another resource might be using the previous name or path
+		auto& group				= group_it->second;
+		const auto name_it		= group.by_name.find(name_previous);
+		const auto path_it		= group.by_path.find(path_previous);
+		const auto name_indexed	= name_it != group.by_name.end() && group.resources[name_it->second] == resource;
+		const auto path_indexed	= path_it != group.by_path.end() && group.resources[path_it->second] == resource;
+		if (!name_indexed && !path_indexed)
+			return;
+
+		// An entry only moves when nothing else is indexed under the new key, otherwise the resource stays findable under the old one
+		const auto index = name_indexed ? name_it->second : path_it->second;
+		if (resource->GetResourceName() != name_previous)
+		{
+			if (group.by_name.emplace(resource->GetResourceName(), index).second)
+			{
+				if (name_indexed)
+				{
+					group.by_name.erase(name_previous);
+				}
+			}
+			else
+			{
+				LOGF_WARNING("A resource named \"%s\" is already cached, keeping \"%s\" under its previous name", resource->GetResourceName().c_str(), name_previous.c_str());
+			}
+		}
+
+		if (resource->GetResourceFilePath() != path_previous)
+		{
+			if (!resource->HasFilePath() || group.by_path.emplace(resource->GetResourceFilePath(), index).second)
+			{
+				if (path_indexed)
+				{
+					group.by_path.erase(path_previous);
+				}
+			}
+			else
+			{
+				LOGF_WARNING("A resource with the path \"%s\" is already cached, keeping \"%s\" under its previous path", resource->GetResourceFilePath().c_str(), path_previous.c_str());
+			}
+		}
+	}
+
+	shared_ptr<ResourceLoad> ResourceCache::LoadBegin(const string& file_path, const Resource_Type type, shared_ptr<IResource>(*create)(Context*), const Streaming_Priority priority, const bool async)
+	{
+		// Mounted archives first, a hash lookup is much cheaper than asking the file system
+		if (!Archive::Exists(file_path) && !FileSystem::FileExists(file_path))
+		{
+			LOGF_ERROR("Path \"%s\" is invalid.", file_path.c_str());
+			return nullptr;
+		}
+
+		// Try to make the path relative to the engine (in case it isn't)
+		auto file_path_relative	= FileSystem::GetRelativeFilePath(file_path);
+		auto name				= FileSystem::GetFileNameNoExtensionFromFilePath(file_path_relative);
+
+		// Loads are keyed by the file they read, checking for them and registering a new one happen under the same lock, so a file is only ever loaded once
+		auto load = make_shared<ResourceLoad>();
+		{
+			lock_guard<mutex> lock(m_mutex);
+			auto& group = m_resource_groups[type];
+
+			// Share the load which is in flight
+			const auto loading = group.loading.find(file_path_relative);
+			if (loading != group.loading.end())
+				return loading->second;
+
+			// Check if the file is already loaded
+			const auto cached = group.by_path.find(file_path_relative);
+			if (cached != group.by_path.end())
+			{
+				load->resource = group.resources[cached->second];
+				return load;
+			}
+
+			// Create new resource, only this load can reach it until it's decoded and cached
+			load->resource	= create(m_context);
+			load->file_path	= file_path_relative;
+			load->counter.Increment();
+			// Set a default name and a default filepath in case it's not overridden by LoadFromFile()
+			load->resource->SetResourceName(name);
+			load->resource->SetResourceFilePath(file_path_relative);
+			load->resource->SetLoadState(LoadState_Started);
+			group.loading[file_path_relative] = load;
+		}
+
+		const auto decode = [this, load]()
+		{
+			if (!LoadDecode(*load))
+			{
+				LoadEnd(*load, false);
+				return;
+			}
+
+			lock_guard<mutex> lock(m_loads_decoded_mutex);
+			m_loads_decoded.emplace_back(load);
+		};
+
+		if (async && m_threading)
+		{
+			// Engine formats are read by the streaming subsystem, so that waiting on the disk doesn't take a worker away, the read calls back on the job system
+			if (m_streaming && (FileSystem::IsEngineModelFile(file_path_relative) || FileSystem::IsEngineTextureFile(file_path_relative)))
+			{
+				load->read = m_streaming->Read(file_path_relative, priority, [load, decode](StreamingResult& result)
+				{
+					// A failed read is left to the decoder, which reports it
+					if (result.success)
+					{
+						load->data = move(result.data);
+					}
+					decode();
+				});
+
+				if (load->read != 0)
+					return load;
+			}
+
+			m_threading->AddTask(decode);
+			return load;
+		}
+
+		// Synchronous loads on the thread which finalizes loads do it all at once, on any other
+		// thread they are finalized like asynchronous loads are, and waited for
+		if (IsFinalizeThread())
+		{
+			LoadEnd(*load, LoadDecode(*load) && load->resource->LoadFromFile_Finalize());
+		}
+		else
+		{
+			decode();
+			Wait(*load);
+		}
+
+		return load;
+	}
+
+	bool ResourceCache::LoadDecode(ResourceLoad& load)
+	{
+		// Decoding can rename the resource or change its file path, which is safe as nothing else can reach it yet.
+		// A file which was read by the streaming subsystem is decoded from memory, if the resource supports it.
+		auto decoded = false;
+		if (!load.data.empty())
+		{
+			decoded = load.resource->LoadFromMemory_Decode(load.file_path, move(load.data));
+			load.data.clear();
+			load.data.shrink_to_fit();
+		}
+		if (!decoded && !load.resource->LoadFromFile_Decode(load.file_path))
+			return false;
+
+		load.resource->SetLoadState(LoadState_Decoded);
+
+		// Cache it under the name and file path it ended up with, and under the file it was loaded from so that loading that file again finds it
+		lock_guard<mutex> lock(m_mutex);
+		auto& group			= m_resource_groups[load.resource->GetResourceType()];
+		const auto index	= static_cast<uint32_t>(group.resources.size());
+		group.resources.emplace_back(load.resource);
+		group.by_name.emplace(load.resource->GetResourceName(), index);
+		group.by_path.emplace(load.resource->GetResourceFilePath(), index);
+		group.by_path.emplace(load.file_path, index);
+
+		return true;
+	}
+
+	void ResourceCache::LoadEnd(ResourceLoad& load, const bool success)
+	{
+		if (!success)
+		{
+			LOGF_ERROR("Failed to load \"%s\".", load.file_path.c_str());
+		}
+		load.resource->SetLoadState(success ? LoadState_Completed : LoadState_Failed);
+
+		{
+			lock_guard<mutex> lock(m_mutex);
+			const auto group = m_resource_groups.find(load.resource->GetResourceType());
+			if (group != m_resource_groups.end())
+			{
+				const auto it = group->second.loading.find(load.file_path);
+				if (it != group->second.loading.end() && it->second.get() == &load)
+				{
+					group->second.loading.erase(it);
+				}
+
+				// A failed resource must not be found, so that the next load of the file tries again
+				if (!success)
+				{
+					Remove(group->second, load.resource);
+				}
+			}
+		}
+
+		load.counter.Decrement();
+	}
+
+	void ResourceCache::Remove(ResourceGroup& group, const shared_ptr<IResource>& resource)
+	{
+		const auto it = find(group.resources.begin(), group.resources.end(), resource);
+		if (it == group.resources.end())
+			return;
+
+		// Swap with the last resource and pop, the indices of the last one move along with it
+		const auto index	= static_cast<uint32_t>(it - group.resources.begin());
+		const auto last		= static_cast<uint32_t>(group.resources.size() - 1);
+		const auto reindex	= [index, last](unordered_map<string, uint32_t>& lookup)
+		{
+			for (auto entry = lookup.begin(); entry != lookup.end();)
+			{
+				if (entry->second == index)
+				{
+					entry = lookup.erase(entry);
+					continue;
+				}
+
+				if (entry->second == last)
+				{
+					entry->second = index;
+				}
+				++entry;
+			}
+		};
+		reindex(group.by_name);
+		reindex(group.by_path);
+
+		group.resources[index] = move(group.resources[last]);
+		group.resources.pop_back();
+	}
+
+	bool ResourceCache::IsFinalizeThread() const
+	{
+		// Before the cache is initialized, whoever loads finalizes
+		return m_finalize_thread_id == thread::id() || m_finalize_thread_id == this_thread::get_id();
+	}
+
+	void ResourceCache::LoadFinalize()
+	{
+		vector<shared_ptr<ResourceLoad>> loads;
+		{
+			lock_guard<mutex> lock(m_loads_decoded_mutex);
+			loads.swap(m_loads_decoded);
+		}
+
+		for (const auto& load : loads)
+		{
+			LoadEnd(*load, load->resource->LoadFromFile_Finalize());
+		}
 	}
 
 	uint32_t ResourceCache::GetResourceCount(const Resource_Type type)
@@ -22,14 +22,20 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 //= INCLUDES ====================
-#include <memory>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <unordered_map>
 #include "Import/ModelImporter.h"
 #include "Import/ImageImporter.h"
 #include "Import/FontImporter.h"
 #include "../Core/ISubsystem.h"
+#include "../Core/EventSystem.h"
 #include "../Rendering/Model.h"
 #include "../RHI/RHI_Texture.h"
+#include "../IO/Streaming.h"
+#include "../Threading/Task.h"
 //===============================
 
 namespace Spartan
@@ -47,6 +53,19 @@ namespace Spartan
 		Asset_Textures
 	};
 
+	class Threading;
+	template <class T> class ResourceHandle;
+
+	// What the handles of a load share
+	struct ResourceLoad
+	{
+		std::shared_ptr<IResource> resource;
+		std::string file_path;	// relative, the load is found by it while in flight
+		TaskCounter counter;	// non-zero while the load is in flight
+		std::atomic<uint64_t> read = 0;	// the streaming read of the file, zero if it's read by the decoder
+		std::vector<std::byte> data;	// the file, once read by the streaming subsystem
+	};
+
 	class SPARTAN_CLASS ResourceCache : public ISubsystem
 	{
 	public:
@@ -55,11 +74,12 @@ namespace Spartan
 
 		//= Subsystem =============
 		bool Initialize() override;
+		void Tick() override;
 		//=========================
 
 		//= GET BY ==============================================================================
 		// NAME
-		std::shared_ptr<IResource>& GetByName(const std::string& name, Resource_Type type);
+		std::shared_ptr<IResource> GetByName(const std::string& name, Resource_Type type);
 		template <class T> 
 		constexpr std::shared_ptr<T> GetByName(const std::string& name) 
 		{ 
@@ -69,19 +89,14 @@ namespace Spartan
 
 		// TYPE
 		std::vector<std::shared_ptr<IResource>> GetByType(Resource_Type type = Resource_Unknown);
+
 		// PATH
+		std::shared_ptr<IResource> GetByPath(const std::string& path, Resource_Type type);
 		template <class T>
-		std::shared_ptr<IResource>& GetByPath(const std::string& path)
+		std::shared_ptr<T> GetByPath(const std::string& path)
 		{
 			VALIDATE_RESOURCE_TYPE(T);
-
-			for (auto& resource : m_resource_groups[IResource::TypeToEnum<T>()])
-			{
-				if (path == resource->GetResourceFilePath())
-					return resource;
-			}
-
-			return m_empty_resource;
+			return std::static_pointer_cast<T>(GetByPath(path, IResource::TypeToEnum<T>()));
 		}
 		//=======================================================================================
 	
@@ -95,72 +110,46 @@ namespace Spartan
 			if (!resource)
 				return;
 
-			// If the resource is already loaded, replace it with the existing one, then early exit
-			if (IsCached(resource->GetResourceName(), resource->GetResourceType()))
-			{
-				resource = GetByName<T>(FileSystem::GetFileNameNoExtensionFromFilePath(resource->GetResourceFilePath()));
-				return;
-			}
-
-			// Cache the resource
-			std::lock_guard<mutex> guard(m_mutex);
-			m_resource_groups[resource->GetResourceType()].emplace_back(resource);
+			resource = std::static_pointer_cast<T>(Insert(resource));
 		}
 		bool IsCached(const std::string& resource_name, Resource_Type resource_type);
 
-		// Loads a resource and adds it to the resource cache
+		// Loads a resource and adds it to the resource cache, returns null if it fails to load. Called from
+		// any thread but the one which ticks the engine, it blocks until that thread finalizes the load.
 		template <class T>
 		std::shared_ptr<T> Load(const std::string& file_path)
 		{
-			VALIDATE_RESOURCE_TYPE(T);
-
-			if (!FileSystem::FileExists(file_path))
-			{
-				LOGF_ERROR("Path \"%s\" is invalid.", file_path.c_str());
-				return false;
-			}
-
-			// Try to make the path relative to the engine (in case it isn't)
-			auto file_path_relative	= FileSystem::GetRelativeFilePath(file_path);
-			auto name				= FileSystem::GetFileNameNoExtensionFromFilePath(file_path_relative);
-
-			// Check if the resource is already loaded
-			if (IsCached(name, IResource::TypeToEnum<T>()))
-			{
-				return GetByName<T>(name);
-			}
-
-			// Create new resource
-			auto typed = std::make_shared<T>(m_context);
-			// Set a default name and a default filepath in case it's not overridden by LoadFromFile()
-			typed->SetResourceName(name);
-			typed->SetResourceFilePath(file_path_relative);
-
-			// Cache it now so LoadFromFile() can safely pass around a reference to the resource from the ResourceManager
-			Cache<T>(typed);
-
-			// Load
-			if (!typed->LoadFromFile(file_path_relative))
-			{
-				LOGF_ERROR("Failed to load \"%s\".", file_path_relative.c_str());
-				return nullptr;
-			}
+			return LoadAsync<T>(file_path, Streaming_Critical, false).Get();
+		}
 
-			// Cache it and cast it
-			return typed;
+		// Queues a load on the job system and returns right away, the resource is cached (and can be found) once it's decoded. Loads of
+		// the same file path share a single load, whether they are asynchronous or not. Async loads finalize during Tick(), so waiting on
+		// one from the thread which ticks the engine finalizes loads while waiting. Engine formats are read by the streaming subsystem
+		// at the given priority, the rest are read by their decoder.
+		template <class T>
+		ResourceHandle<T> LoadAsync(const std::string& file_path, const Streaming_Priority priority = Streaming_Prefetch, const bool async = true)
+		{
+			VALIDATE_RESOURCE_TYPE(T);
+			return ResourceHandle<T>(LoadBegin(file_path, IResource::TypeToEnum<T>(), [](Context* context) -> std::shared_ptr<IResource> { return std::make_shared<T>(context); }, priority, async), this);
 		}
+
+		// Blocks until the load is done (or has failed), a read which hasn't started yet becomes critical
+		void Wait(const ResourceLoad& load);
 		//===============================================================================================================
 
-		//= I/O ======================
+		//= I/O ===========================================================================================================
 		void SaveResourcesToFiles();
 		void LoadResourcesFromFiles();
-		//============================
+		// Packs the resource list and every resource into one archive, which is mounted when the world loads. Its files are
+		// preferred over the loose ones, so saving a world which was loaded from an archive packs it again.
+		bool SaveResourcesToArchive(bool compress = true);
+		//==================================================================================================================
 
 		//= MISC ============================================================
 		// Memory
 		uint32_t GetMemoryUsage(Resource_Type type = Resource_Unknown);
 		// Unloads all resources
-		void Clear() { m_resource_groups.clear(); }
+		void Clear();
 		// Returns all resources of a given type
 		uint32_t GetResourceCount(Resource_Type type = Resource_Unknown);
 		//===================================================================
@@ -180,19 +169,94 @@ namespace Spartan
 		FontImporter* GetFontImporter() const	{ return m_importer_font.get(); }
 
 	private:
+		// Resources of a type, along with indices into them by name and by file path, and the loads in flight by file path
+		struct ResourceGroup
+		{
+			std::vector<std::shared_ptr<IResource>> resources;
+			std::unordered_map<std::string, uint32_t> by_name;
+			std::unordered_map<std::string, uint32_t> by_path;
+			std::unordered_map<std::string, std::shared_ptr<ResourceLoad>> loading;
+		};
+
+		// Returns the cached resource with the same name, or the provided one once cached
+		std::shared_ptr<IResource> Insert(const std::shared_ptr<IResource>& resource);
+		static std::shared_ptr<IResource> Insert(ResourceGroup& group, const std::shared_ptr<IResource>& resource);
+		// Removes the resource and its index entries, only used for loads which failed (which are rare), so it scans the indices
+		static void Remove(ResourceGroup& group, const std::shared_ptr<IResource>& resource);
+
+		// Packs the resource list and the resources, as they are on disk
+		bool PackResources(const std::string& archive_path, bool compress);
+
+		// Loading
+		std::shared_ptr<ResourceLoad> LoadBegin(const std::string& file_path, Resource_Type type, std::shared_ptr<IResource>(*create)(Context*), Streaming_Priority priority, bool async);
+		bool LoadDecode(ResourceLoad& load);
+		void LoadEnd(ResourceLoad& load, bool success);
+		void LoadFinalize();
+		bool IsFinalizeThread() const;
+		// The indices use the name and file path a resource had when it was cached, so they have to be updated when those change
+		void Reindex(const std::shared_ptr<IResource>& resource, const std::string& name_previous, const std::string& path_previous);
+
 		// Cache
-		std::map<Resource_Type, std::vector<std::shared_ptr<IResource>>> m_resource_groups;
+		std::map<Resource_Type, ResourceGroup> m_resource_groups;
 		std::mutex m_mutex;
 
+		// Loads which are decoded and wait to be finalized, on the thread which ticks the engine
+		std::vector<std::shared_ptr<ResourceLoad>> m_loads_decoded;
+		std::mutex m_loads_decoded_mutex;
+		std::thread::id m_finalize_thread_id;
+
 		// Directories
 		std::map<Asset_Type, std::string> m_standard_resource_directories;
 		std::string m_project_directory;
+		std::string m_archive_path;
 
 		// Importers
 		std::shared_ptr<ModelImporter> m_importer_model;
 		std::shared_ptr<ImageImporter> m_importer_image;
 		std::shared_ptr<FontImporter> m_importer_font;
 
-		std::shared_ptr<IResource> m_empty_resource = nullptr;
+		Subscription m_subscription_world_unload = 0;
+
+		// Dependencies
+		Threading* m_threading = nullptr;
+		Streaming* m_streaming = nullptr;
+	};
+
+	// A future-like handle to a resource which might still be loading
+	template <class T>
+	class ResourceHandle
+	{
+	public:
+		ResourceHandle() = default;
+		ResourceHandle(std::shared_ptr<ResourceLoad> load, ResourceCache* cache) : m_load(std::move(load)), m_cache(cache) {}
+
+		// Handles of different types can be kept together as handles of a common base
+		template <class U, class = typename std::enable_if<std::is_base_of<T, U>::value>::type>
+		ResourceHandle(const ResourceHandle<U>& other) : m_load(other.m_load), m_cache(other.m_cache) {}
+
+		auto IsValid() const		{ return m_load != nullptr; }
+		auto IsReady() const		{ return !m_load || m_load->counter.IsDone(); }
+		LoadState GetLoadState() const	{ return m_load ? m_load->resource->GetLoadState() : LoadState_Failed; }
+
+		void Wait() const
+		{
+			if (m_load)
+			{
+				m_cache->Wait(*m_load);
+			}
+		}
+
+		// Waits for the load, then returns the resource or null if it failed to load
+		std::shared_ptr<T> Get() const
+		{
+			Wait();
+			return (m_load && m_load->resource->GetLoadState() != LoadState_Failed) ? std::static_pointer_cast<T>(m_load->resource) : nullptr;
+		}
+
+	private:
+		template <class U> friend class ResourceHandle;
+
+		std::shared_ptr<ResourceLoad> m_load;
+		ResourceCache* m_cache = nullptr;
 	};
 }
\ No newline at end of file
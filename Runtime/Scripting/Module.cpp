@@ -33,7 +33,7 @@ using namespace std;
 
 namespace Spartan
 {
-	Module::Module(const string& moduleName, weak_ptr<Scripting> scriptEngine)
+	Module::Module(const string& moduleName, Scripting* scriptEngine)
 	{
 		m_moduleName	= moduleName;
 		m_scriptEngine	= scriptEngine;
@@ -41,16 +41,15 @@ namespace Spartan
 
 	Module::~Module()
 	{
-		if (auto scriptEngine = m_scriptEngine.lock())
+		if (m_scriptEngine)
 		{
-			scriptEngine->DiscardModule(m_moduleName);
+			m_scriptEngine->DiscardModule(m_moduleName);
 		}
 	}
 
 	bool Module::LoadScript(const string& filePath)
 	{
-		auto scriptEngine = m_scriptEngine.lock();
-		if (!scriptEngine)
+		if (!m_scriptEngine)
 		{
 			LOG_ERROR_INVALID_INTERNALS();
 			return false;
@@ -58,7 +57,7 @@ namespace Spartan
 
 		// start new module
 		m_scriptBuilder = make_unique<CScriptBuilder>();
-		int result = m_scriptBuilder->StartNewModule(scriptEngine->GetAsIScriptEngine(), m_moduleName.c_str());
+		int result = m_scriptBuilder->StartNewModule(m_scriptEngine->GetAsIScriptEngine(), m_moduleName.c_str());
 		if (result < 0)
 		{
 			LOG_ERROR("Failed to start new module, make sure there is enough memory for it to be allocated.");
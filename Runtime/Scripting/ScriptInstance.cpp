@@ -54,7 +54,7 @@ namespace Spartan
 		m_isInstantiated		= false;
 	}
 
-	bool ScriptInstance::Instantiate(const string& path, std::weak_ptr<Entity> entity, shared_ptr<Scripting> scriptEngine)
+	bool ScriptInstance::Instantiate(const string& path, std::weak_ptr<Entity> entity, Scripting* scriptEngine)
 	{
 		if (entity.expired())
 			return false;
@@ -143,7 +143,7 @@ namespace Spartan
 	------------------------------------------------------------------------------*/
 	void ScriptInterface::RegisterInput()
 	{
-		m_scriptEngine->RegisterGlobalProperty("Input input", m_context->GetSubsystem<Input>().get());
+		m_scriptEngine->RegisterGlobalProperty("Input input", m_context->GetSubsystem<Input>());
 		m_scriptEngine->RegisterObjectMethod("Input", "Vector2 &GetMousePosition()", asMETHOD(Input, GetMousePosition), asCALL_THISCALL);
 		m_scriptEngine->RegisterObjectMethod("Input", "Vector2 &GetMouseDelta()", asMETHOD(Input, GetMouseDelta), asCALL_THISCALL);
 		m_scriptEngine->RegisterObjectMethod("Input", "bool GetKey(KeyCode key)", asMETHOD(Input, GetKey), asCALL_THISCALL);
@@ -156,7 +156,7 @@ namespace Spartan
 	------------------------------------------------------------------------------*/
 	void ScriptInterface::RegisterTime()
 	{
-		m_scriptEngine->RegisterGlobalProperty("Time time", m_context->GetSubsystem<Timer>().get());
+		m_scriptEngine->RegisterGlobalProperty("Time time", m_context->GetSubsystem<Timer>());
 		m_scriptEngine->RegisterObjectMethod("Time", "float GetDeltaTime()", asMETHOD(Timer, GetDeltaTimeSec), asCALL_THISCALL);
 	}
 
@@ -172,9 +172,9 @@ namespace Spartan
 		m_scriptEngine->RegisterObjectMethod("Entity", "bool IsActive()", asMETHOD(Entity, IsActive), asCALL_THISCALL);
 		m_scriptEngine->RegisterObjectMethod("Entity", "void SetActive(bool)", asMETHOD(Entity, SetActive), asCALL_THISCALL);
 		m_scriptEngine->RegisterObjectMethod("Entity", "Transform &GetTransform()", asMETHOD(Entity, GetTransform_PtrRaw), asCALL_THISCALL);	
-		m_scriptEngine->RegisterObjectMethod("Entity", "Camera &GetCamera()", asMETHOD(Entity, GetComponent<Camera>), asCALL_THISCALL);
-		m_scriptEngine->RegisterObjectMethod("Entity", "RigidBody &GetRigidBody()", asMETHOD(Entity, GetComponent<RigidBody>), asCALL_THISCALL);
-		m_scriptEngine->RegisterObjectMethod("Entity", "Renderable &GetRenderable()", asMETHOD(Entity, GetComponent<Renderable>), asCALL_THISCALL);
+		m_scriptEngine->RegisterObjectMethod("Entity", "Camera &GetCamera()", asMETHOD(Entity, GetComponent_PtrRaw<Camera>), asCALL_THISCALL);
+		m_scriptEngine->RegisterObjectMethod("Entity", "RigidBody &GetRigidBody()", asMETHOD(Entity, GetComponent_PtrRaw<RigidBody>), asCALL_THISCALL);
+		m_scriptEngine->RegisterObjectMethod("Entity", "Renderable &GetRenderable()", asMETHOD(Entity, GetComponent_PtrRaw<Renderable>), asCALL_THISCALL);
 	}
 
 	/*------------------------------------------------------------------------------
@@ -0,0 +1,120 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==========
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+//=====================
+
+namespace Spartan
+{
+	// Tracks a batch of tasks, reaches zero once every task in the batch has executed
+	class TaskCounter
+	{
+	public:
+		TaskCounter() = default;
+		TaskCounter(const TaskCounter&) = delete;
+		TaskCounter& operator=(const TaskCounter&) = delete;
+
+		void Increment(const uint32_t count = 1)	{ m_count.fetch_add(count, std::memory_order_relaxed); }
+		void Decrement()							{ m_count.fetch_sub(1, std::memory_order_release); }
+		bool IsDone() const							{ return m_count.load(std::memory_order_acquire) == 0; }
+		uint32_t GetCount() const					{ return m_count.load(std::memory_order_acquire); }
+
+	private:
+		std::atomic<uint32_t> m_count = 0;
+	};
+
+	// A type erased callable with inline storage, small functions never touch the heap
+	class alignas(64) Task
+	{
+	public:
+		Task() = default;
+		~Task() { Reset(); }
+
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+
+		template <typename Function>
+		void Set(Function&& function, TaskCounter* counter)
+		{
+			using function_type = typename std::decay<Function>::type;
+
+			Reset();
+			if constexpr (sizeof(function_type) <= storage_size && alignof(function_type) <= alignof(std::max_align_t))
+			{
+				new (m_storage) function_type(std::forward<Function>(function));
+				m_invoke	= [](void* storage) { (*static_cast<function_type*>(storage))(); };
+				m_destroy	= [](void* storage) { static_cast<function_type*>(storage)->~function_type(); };
+			}
+			else
+			{
+				// Too big for the inline storage, fall back to the heap
+				*reinterpret_cast<function_type**>(m_storage) = new function_type(std::forward<Function>(function));
+				m_invoke	= [](void* storage) { (**static_cast<function_type**>(storage))(); };
+				m_destroy	= [](void* storage) { delete *static_cast<function_type**>(storage); };
+			}
+			m_counter = counter;
+		}
+
+		void Execute()
+		{
+			m_invoke(m_storage);
+
+			// Release captured state before signalling, waiters may reuse it right away
+			TaskCounter* counter = m_counter;
+			Reset();
+			if (counter)
+			{
+				counter->Decrement();
+			}
+		}
+
+		// Index inside the owning pool, or pool_index_none if heap allocated
+		uint32_t m_pool_index				= 0;
+		std::atomic<uint32_t> m_pool_next	= 0;
+		static constexpr uint32_t pool_index_none = ~0U;
+
+	private:
+		void Reset()
+		{
+			if (m_destroy)
+			{
+				m_destroy(m_storage);
+			}
+			m_invoke	= nullptr;
+			m_destroy	= nullptr;
+			m_counter	= nullptr;
+		}
+
+		static constexpr size_t storage_size = 64;
+		alignas(std::max_align_t) unsigned char m_storage[storage_size];
+		void (*m_invoke)(void*)		= nullptr;
+		void (*m_destroy)(void*)	= nullptr;
+		TaskCounter* m_counter		= nullptr;
+	};
+}
@@ -0,0 +1,127 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES ==========
+#include "TaskGraph.h"
+#include "Threading.h"
+//=====================
+
+//= NAMESPACES =====
+using namespace std;
+//==================
+
+namespace Spartan
+{
+	TaskGraph::Node TaskGraph::Add(function<void()>&& function, const initializer_list<Node> dependencies)
+	{
+		if (!m_counter.IsDone())
+		{
+			LOG_ERROR("Can't modify a graph while it's executing");
+			return node_null;
+		}
+
+		// Dependencies must already be in the graph, which also rejects node_null
+		const auto node = static_cast<Node>(m_nodes.size());
+		for (const auto dependency : dependencies)
+		{
+			if (dependency >= node)
+			{
+				LOGF_ERROR("Invalid dependency %u, dependencies must be added first", dependency);
+				return node_null;
+			}
+		}
+
+		auto node_data		= make_unique<NodeData>();
+		node_data->function	= move(function);
+		for (const auto dependency : dependencies)
+		{
+			m_nodes[dependency]->dependants.emplace_back(node);
+			node_data->dependency_count++;
+		}
+
+		m_nodes.emplace_back(move(node_data));
+		return node;
+	}
+
+	void TaskGraph::Submit()
+	{
+		if (!m_threading)
+		{
+			LOG_ERROR_INVALID_INTERNALS();
+			return;
+		}
+
+		if (!m_counter.IsDone())
+		{
+			LOG_WARNING("The graph is already executing");
+			return;
+		}
+
+		// Reset dependency counts and account for every node up front, so that the
+		// counter can't reach zero while dependants are still waiting to be scheduled
+		for (auto& node : m_nodes)
+		{
+			node->dependencies_remaining.store(node->dependency_count, memory_order_relaxed);
+		}
+		m_counter.Increment(static_cast<uint32_t>(m_nodes.size()));
+
+		for (Node node = 0; node < static_cast<Node>(m_nodes.size()); node++)
+		{
+			if (m_nodes[node]->dependency_count == 0)
+			{
+				Schedule(node);
+			}
+		}
+	}
+
+	void TaskGraph::Wait()
+	{
+		if (m_threading)
+		{
+			m_threading->Wait(m_counter);
+		}
+	}
+
+	void TaskGraph::Clear()
+	{
+		Wait();
+		m_nodes.clear();
+	}
+
+	void TaskGraph::Schedule(const Node node)
+	{
+		m_threading->AddTask([this, node]()
+		{
+			NodeData* node_data = m_nodes[node].get();
+			node_data->function();
+
+			for (const auto dependant : node_data->dependants)
+			{
+				if (m_nodes[dependant]->dependencies_remaining.fetch_sub(1, memory_order_acq_rel) == 1)
+				{
+					Schedule(dependant);
+				}
+			}
+
+			m_counter.Decrement();
+		});
+	}
+}
@@ -0,0 +1,92 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ==================
+#include <vector>
+#include <memory>
+#include <functional>
+#include <initializer_list>
+#include "Task.h"
+#include "../Core/EngineDefs.h"
+//=============================
+
+namespace Spartan
+{
+	class Threading;
+
+	/*
+	HOW TO USE
+	===================================================================
+	TaskGraph graph(threading);
+	auto load	= graph.Add([]() { ... });
+	auto decode	= graph.Add([]() { ... }, { load });
+	graph.Then(decode, []() { ... });
+	graph.Submit();
+	graph.Wait();
+
+	Dependencies must be added before their dependants, so a graph can
+	never contain a cycle. A graph can be submitted again once it's done.
+	===================================================================
+	*/
+	class SPARTAN_CLASS TaskGraph
+	{
+	public:
+		typedef uint32_t Node;
+		static const Node node_null = ~0U;
+
+		TaskGraph(Threading* threading) { m_threading = threading; }
+		~TaskGraph() { Wait(); }
+
+		// Adds a node which will execute once all of its dependencies have executed.
+		// Returns node_null if the graph is executing or a dependency is invalid (e.g. node_null).
+		Node Add(std::function<void()>&& function, std::initializer_list<Node> dependencies = {});
+
+		// Adds a node which executes after the given node (continuation)
+		Node Then(const Node node, std::function<void()>&& function) { return Add(std::move(function), { node }); }
+
+		// Schedules every node without dependencies, the rest follow as their dependencies complete
+		void Submit();
+
+		// Blocks until every node has executed, the calling thread helps in the meantime
+		void Wait();
+
+		bool IsDone() const		{ return m_counter.IsDone(); }
+		uint32_t GetSize() const	{ return static_cast<uint32_t>(m_nodes.size()); }
+		void Clear();
+
+	private:
+		struct NodeData
+		{
+			std::function<void()> function;
+			std::vector<Node> dependants;
+			uint32_t dependency_count = 0;
+			std::atomic<uint32_t> dependencies_remaining = 0;
+		};
+
+		void Schedule(Node node);
+
+		std::vector<std::unique_ptr<NodeData>> m_nodes;
+		TaskCounter m_counter;
+		Threading* m_threading = nullptr;
+	};
+}
@@ -0,0 +1,175 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES ======
+#include <atomic>
+#include <memory>
+#include "Task.h"
+//=================
+
+namespace Spartan
+{
+	// Chase-Lev work stealing deque (Le, Pop, Cohen, Nardelli - "Correct and Efficient Work-Stealing for Weak Memory Models")
+	// The owning thread pushes and pops at the bottom, any other thread can steal from the top.
+	class TaskDeque
+	{
+	public:
+		TaskDeque(const uint32_t capacity = 4096)
+		{
+			// Capacity must be a power of two so that wrapping is a mask
+			uint32_t size = 1;
+			while (size < capacity) size <<= 1;
+
+			m_mask		= size - 1;
+			m_buffer	= std::make_unique<std::atomic<Task*>[]>(size);
+		}
+
+		// Owner only, returns false if the deque is full
+		bool Push(Task* task)
+		{
+			const int64_t bottom	= m_bottom.load(std::memory_order_relaxed);
+			const int64_t top		= m_top.load(std::memory_order_acquire);
+			if (bottom - top > static_cast<int64_t>(m_mask))
+				return false;
+
+			m_buffer[bottom & m_mask].store(task, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		// Owner only, LIFO
+		Task* Pop()
+		{
+			const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			m_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = m_top.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				// Empty
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			Task* task = m_buffer[bottom & m_mask].load(std::memory_order_relaxed);
+			if (top == bottom)
+			{
+				// Last item, race against thieves
+				if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				{
+					task = nullptr;
+				}
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return task;
+		}
+
+		// Any thread, FIFO
+		Task* Steal()
+		{
+			int64_t top = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+				return nullptr;
+
+			Task* task = m_buffer[top & m_mask].load(std::memory_order_relaxed);
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+
+			return task;
+		}
+
+		bool IsEmpty() const { return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed); }
+
+	private:
+		alignas(64) std::atomic<int64_t> m_top		= 0;
+		alignas(64) std::atomic<int64_t> m_bottom	= 0;
+		std::unique_ptr<std::atomic<Task*>[]> m_buffer;
+		uint32_t m_mask = 0;
+	};
+
+	// Fixed size pool of tasks with a lock-free free list, the head is tagged to avoid ABA
+	class TaskPool
+	{
+	public:
+		TaskPool(const uint32_t capacity = 8192)
+		{
+			m_tasks = std::make_unique<Task[]>(capacity);
+			for (uint32_t i = 0; i < capacity; i++)
+			{
+				m_tasks[i].m_pool_index = i;
+				m_tasks[i].m_pool_next.store(i + 1 < capacity ? i + 1 : Task::pool_index_none, std::memory_order_relaxed);
+			}
+			m_head.store(Pack(0, capacity ? 0 : Task::pool_index_none), std::memory_order_relaxed);
+		}
+
+		// Returns a pooled task, or a heap allocated one if the pool is exhausted
+		Task* Allocate()
+		{
+			uint64_t head = m_head.load(std::memory_order_acquire);
+			while (true)
+			{
+				const uint32_t index = static_cast<uint32_t>(head);
+				if (index == Task::pool_index_none)
+				{
+					Task* task			= new Task();
+					task->m_pool_index	= Task::pool_index_none;
+					return task;
+				}
+
+				const uint32_t next = m_tasks[index].m_pool_next.load(std::memory_order_relaxed);
+				if (m_head.compare_exchange_weak(head, Pack(Tag(head) + 1, next), std::memory_order_acq_rel, std::memory_order_acquire))
+					return &m_tasks[index];
+			}
+		}
+
+		void Free(Task* task)
+		{
+			if (task->m_pool_index == Task::pool_index_none)
+			{
+				delete task;
+				return;
+			}
+
+			uint64_t head = m_head.load(std::memory_order_relaxed);
+			while (true)
+			{
+				task->m_pool_next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+				if (m_head.compare_exchange_weak(head, Pack(Tag(head) + 1, task->m_pool_index), std::memory_order_release, std::memory_order_relaxed))
+					return;
+			}
+		}
+
+	private:
+		static uint64_t Pack(const uint32_t tag, const uint32_t index)	{ return (static_cast<uint64_t>(tag) << 32) | index; }
+		static uint32_t Tag(const uint64_t head)						{ return static_cast<uint32_t>(head >> 32); }
+
+		std::unique_ptr<Task[]> m_tasks;
+		alignas(64) std::atomic<uint64_t> m_head = 0;
+	};
+}
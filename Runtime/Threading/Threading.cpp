@@ -30,33 +30,44 @@ using namespace std;
 
 namespace Spartan
 {
+	namespace _Threading
+	{
+		static const uint32_t queue_index_none = ~0U;
+		static thread_local uint32_t queue_index = queue_index_none;
+		static const uint32_t spin_count = 64;
+	}
+
 	Threading::Threading(Context* context) : ISubsystem(context)
 	{
-		m_stopping		= false;
-		m_threadCount	= Settings::Get().GetMaxThreadCount() - 1;
+		m_thread_count		= Settings::Get().GetMaxThreadCount() - 1;
+		m_queue_index_main	= m_thread_count;
+
+		for (uint32_t i = 0; i <= m_thread_count; i++)
+		{
+			m_queues.emplace_back(make_unique<TaskDeque>());
+		}
 
-		for (uint32_t i = 0; i < m_threadCount; i++)
+		// The thread which creates the subsystem owns the last deque
+		_Threading::queue_index = m_queue_index_main;
+
+		for (uint32_t i = 0; i < m_thread_count; i++)
 		{
-			m_threads.emplace_back(thread(&Threading::Invoke, this));
+			m_threads.emplace_back(thread(&Threading::Invoke, this, i));
 		}
-		LOGF_INFO("%d threads have been created", m_threadCount);
+		LOGF_INFO("%d threads have been created", m_thread_count);
 	}
 
 	Threading::~Threading()
 	{
-		// Put unique lock on task mutex.
-		unique_lock<mutex> lock(m_tasksMutex);
-
 		// Set termination flag to true.
+		unique_lock<mutex> lock(m_sleep_mutex);
 		m_stopping = true;
-
-		// Unlock the mutex
 		lock.unlock();
 
 		// Wake up all threads.
-		m_conditionVar.notify_all();
+		m_condition_var.notify_all();
 
-		// Join all threads.
+		// Join all threads, they will drain any remaining tasks first.
 		for (auto& thread : m_threads)
 		{
 			thread.join();
@@ -64,34 +75,134 @@ namespace Spartan
 
 		// Empty worker threads.
 		m_threads.clear();
+
+		if (_Threading::queue_index == m_queue_index_main)
+		{
+			_Threading::queue_index = _Threading::queue_index_none;
+		}
 	}
 
-	void Threading::Invoke()
+	void Threading::Wait(const TaskCounter& counter)
 	{
-		shared_ptr<Task> task;
-		while (true)
+		while (!counter.IsDone())
 		{
-			// Lock tasks mutex
-			unique_lock<mutex> lock(m_tasksMutex);
+			if (!TryExecute())
+			{
+				this_thread::yield();
+			}
+		}
+	}
 
-			// Check condition on notification
-			m_conditionVar.wait(lock, [this] { return !m_tasks.empty() || m_stopping; });
+	bool Threading::TryExecute()
+	{
+		Task* task = Acquire(_Threading::queue_index);
+		if (!task)
+			return false;
+
+		Execute(task);
+		return true;
+	}
 
-			// If m_stopping is true, it's time to shut everything down
-			if (m_stopping && m_tasks.empty())
+	void Threading::Invoke(const uint32_t queue_index)
+	{
+		_Threading::queue_index = queue_index;
+
+		while (true)
+		{
+			// Spin for a while before going to sleep, fine grained work tends to arrive in bursts
+			Task* task = nullptr;
+			for (uint32_t i = 0; i < _Threading::spin_count && !task; i++)
+			{
+				task = Acquire(queue_index);
+			}
+
+			if (task)
+			{
+				Execute(task);
+				continue;
+			}
+
+			// Nothing to do, sleep until a task is submitted
+			unique_lock<mutex> lock(m_sleep_mutex);
+			m_threads_sleeping++;
+			m_condition_var.wait(lock, [this] { return m_tasks_pending.load() > 0 || m_stopping; });
+			m_threads_sleeping--;
+
+			// If m_stopping is true and there is no work left, it's time to shut everything down
+			if (m_stopping && m_tasks_pending.load() <= 0)
 				return;
+		}
+	}
+
+	void Threading::Submit(Task* task)
+	{
+		// Count before publishing so that a thief can't decrement first
+		m_tasks_pending++;
 
-			// Get next task in the queue.
-			task = m_tasks.front();
+		const uint32_t queue_index = _Threading::queue_index;
+		if (queue_index == _Threading::queue_index_none || !m_queues[queue_index]->Push(task))
+		{
+			lock_guard<mutex> lock(m_tasks_external_mutex);
+			m_tasks_external.push(task);
+			m_tasks_external_count++;
+		}
 
-			// Remove it from the queue.
-			m_tasks.pop();
+		// Wake up a thread, only pay for the lock if someone is actually sleeping
+		if (m_threads_sleeping.load() > 0)
+		{
+			{ lock_guard<mutex> lock(m_sleep_mutex); }
+			m_condition_var.notify_one();
+		}
+	}
 
-			// Unlock the mutex
-			lock.unlock();
+	Task* Threading::Acquire(const uint32_t queue_index)
+	{
+		Task* task = nullptr;
 
-			// Execute the task.
-			task->Execute();
+		// Own deque first, newest task is the most likely to be hot in cache
+		if (queue_index != _Threading::queue_index_none)
+		{
+			task = m_queues[queue_index]->Pop();
 		}
+
+		// Tasks from threads without a deque, only pay for the lock if there are any
+		if (!task && m_tasks_external_count.load() > 0)
+		{
+			lock_guard<mutex> lock(m_tasks_external_mutex);
+			if (!m_tasks_external.empty())
+			{
+				task = m_tasks_external.front();
+				m_tasks_external.pop();
+				m_tasks_external_count--;
+			}
+		}
+
+		// Steal from the others, starting next to us so that thieves spread out
+		if (!task)
+		{
+			const auto queue_count	= static_cast<uint32_t>(m_queues.size());
+			const uint32_t start	= queue_index != _Threading::queue_index_none ? queue_index + 1 : 0;
+			for (uint32_t i = 0; i < queue_count && !task; i++)
+			{
+				const uint32_t victim = (start + i) % queue_count;
+				if (victim != queue_index)
+				{
+					task = m_queues[victim]->Steal();
+				}
+			}
+		}
+
+		if (task)
+		{
+			m_tasks_pending--;
+		}
+
+		return task;
+	}
+
+	void Threading::Execute(Task* task)
+	{
+		task->Execute();
+		m_task_pool.Free(task);
 	}
-}
\ No newline at end of file
+}
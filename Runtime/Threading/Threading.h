@@ -21,71 +21,119 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #pragma once
 
-//= INCLUDES =================
+//= INCLUDES ==================
 #include <vector>
 #include <thread>
 #include <mutex>
 #include <queue>
-#include <functional>
+#include <atomic>
+#include <condition_variable>
+#include "TaskQueue.h"
 #include "../Logging/Log.h"
 #include "../Core/ISubsystem.h"
-//============================
+//=============================
 
 namespace Spartan
 {
-	//= TASK ===============================================================================
-	class Task
-	{
-	public:
-		typedef std::function<void()> functionType;
-
-		Task(functionType&& function) { m_function = std::forward<functionType>(function); }
-		void Execute() { m_function(); }
-
-	private:
-		functionType m_function;
-	};
-	//======================================================================================
-
 	class Threading : public ISubsystem
 	{
 	public:
 		Threading(Context* context);
 		~Threading();
 
-		// This function is invoked by the threads
-		void Invoke();
-
-		// Add a task
+		// Add a task, if a counter is provided it will be incremented now and decremented once the task has executed
 		template <typename Function>
-		void AddTask(Function&& function)
+		void AddTask(Function&& function, TaskCounter* counter = nullptr)
 		{
+			if (counter)
+			{
+				counter->Increment();
+			}
+
 			if (m_threads.empty())
 			{
 				LOG_WARNING("Threading::AddTask: No available threads, function will execute in the same thread");
 				function();
+				if (counter)
+				{
+					counter->Decrement();
+				}
 				return;
 			}
 
-			// Lock tasks mutex
-			std::unique_lock<std::mutex> lock(m_tasksMutex);
+			Task* task = m_task_pool.Allocate();
+			task->Set(std::forward<Function>(function), counter);
+			Submit(task);
+		}
 
-			// Save the task
-			m_tasks.push(std::make_shared<Task>(std::bind(std::forward<Function>(function))));
+		// Splits [0, range) into chunks of grain indices and calls function(index) for each index, returns once all are done
+		template <typename Function>
+		void ParallelFor(const uint32_t range, const uint32_t grain, Function&& function)
+		{
+			if (range == 0)
+				return;
+
+			const uint32_t grain_size	= grain != 0 ? grain : 1;
+			const uint32_t chunk_count	= (range + grain_size - 1) / grain_size;
 
-			// Unlock the mutex
-			lock.unlock();
+			// The calling thread takes the first chunk, the rest goes to the workers
+			TaskCounter counter;
+			for (uint32_t chunk = 1; chunk < chunk_count; chunk++)
+			{
+				const uint32_t start	= chunk * grain_size;
+				const uint32_t end		= (range - start) > grain_size ? start + grain_size : range;
+				AddTask([&function, start, end]()
+				{
+					for (uint32_t i = start; i < end; i++)
+					{
+						function(i);
+					}
+				}, &counter);
+			}
+
+			const uint32_t end = range > grain_size ? grain_size : range;
+			for (uint32_t i = 0; i < end; i++)
+			{
+				function(i);
+			}
 
-			// Wake up a thread
-			m_conditionVar.notify_one();
+			Wait(counter);
 		}
 
+		// Blocks until the counter reaches zero, the calling thread executes pending tasks while waiting
+		void Wait(const TaskCounter& counter);
+
+		// Executes a pending task on the calling thread, returns false if there was none. For threads
+		// which wait on more than a counter and have to keep checking in between tasks.
+		bool TryExecute();
+
+		uint32_t GetThreadCount() const { return m_thread_count; }
+
 	private:
-		uint32_t m_threadCount;
+		// This function is invoked by the threads
+		void Invoke(uint32_t queue_index);
+
+		void Submit(Task* task);
+		Task* Acquire(uint32_t queue_index);
+		void Execute(Task* task);
+
+		uint32_t m_thread_count;
 		std::vector<std::thread> m_threads;
-		std::queue<std::shared_ptr<Task>> m_tasks;
-		std::mutex m_tasksMutex;
-		std::condition_variable m_conditionVar;
-		bool m_stopping;
+
+		// One deque per worker plus one for the thread that created the subsystem (the main thread)
+		std::vector<std::unique_ptr<TaskDeque>> m_queues;
+		uint32_t m_queue_index_main;
+
+		// Tasks added by threads which don't own a deque
+		std::queue<Task*> m_tasks_external;
+		std::mutex m_tasks_external_mutex;
+		std::atomic<uint32_t> m_tasks_external_count = 0;
+
+		TaskPool m_task_pool;
+		std::atomic<int32_t> m_tasks_pending	= 0;
+		std::atomic<uint32_t> m_threads_sleeping	= 0;
+		std::mutex m_sleep_mutex;
+		std::condition_variable m_condition_var;
+		std::atomic<bool> m_stopping			= false;
 	};
-}
\ No newline at end of file
+}
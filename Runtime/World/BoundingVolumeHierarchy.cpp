@@ -0,0 +1,355 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//= INCLUDES =========================
+#include "BoundingVolumeHierarchy.h"
+//====================================
+
+//= NAMESPACES ================
+using namespace std;
+using namespace Spartan::Math;
+//=============================
+
+namespace Spartan
+{
+	namespace _BoundingVolumeHierarchy
+	{
+		// How much leaf boxes are enlarged by, in world units
+		static const float margin = 0.1f;
+
+		inline BoundingBox Merged(const BoundingBox& a, const BoundingBox& b)
+		{
+			return BoundingBox
+			(
+				Vector3(Helper::Min(a.GetMin().x, b.GetMin().x), Helper::Min(a.GetMin().y, b.GetMin().y), Helper::Min(a.GetMin().z, b.GetMin().z)),
+				Vector3(Helper::Max(a.GetMax().x, b.GetMax().x), Helper::Max(a.GetMax().y, b.GetMax().y), Helper::Max(a.GetMax().z, b.GetMax().z))
+			);
+		}
+
+		// Surface area, the cost metric used when choosing where to insert
+		inline float Area(const BoundingBox& box)
+		{
+			const Vector3 size = box.GetSize();
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+	}
+
+	uint32_t BoundingVolumeHierarchy::Insert(const BoundingBox& box, Entity* entity)
+	{
+		const auto id		= NodeAllocate();
+		auto& node			= m_nodes[id];
+		const Vector3 margin(_BoundingVolumeHierarchy::margin, _BoundingVolumeHierarchy::margin, _BoundingVolumeHierarchy::margin);
+		node.box			= BoundingBox(box.GetMin() - margin, box.GetMax() + margin);
+		node.entity			= entity;
+		node.height			= 0;
+
+		LeafInsert(id);
+		m_leaf_count++;
+
+		return id;
+	}
+
+	void BoundingVolumeHierarchy::Remove(const uint32_t id)
+	{
+		if (id >= static_cast<uint32_t>(m_nodes.size()) || !m_nodes[id].IsLeaf() || m_nodes[id].height < 0)
+			return;
+
+		LeafRemove(id);
+		NodeFree(id);
+		m_leaf_count--;
+	}
+
+	bool BoundingVolumeHierarchy::Move(const uint32_t id, const BoundingBox& box)
+	{
+		if (id >= static_cast<uint32_t>(m_nodes.size()) || !m_nodes[id].IsLeaf() || m_nodes[id].height < 0)
+			return false;
+
+		// Still within the enlarged box, nothing to do
+		if (m_nodes[id].box.IsInside(box) == Helper::Inside)
+			return false;
+
+		LeafRemove(id);
+		const Vector3 margin(_BoundingVolumeHierarchy::margin, _BoundingVolumeHierarchy::margin, _BoundingVolumeHierarchy::margin);
+		m_nodes[id].box = BoundingBox(box.GetMin() - margin, box.GetMax() + margin);
+		LeafInsert(id);
+
+		return true;
+	}
+
+	void BoundingVolumeHierarchy::Clear()
+	{
+		m_nodes.clear();
+		m_root			= node_null;
+		m_free			= node_null;
+		m_leaf_count	= 0;
+	}
+
+	uint32_t BoundingVolumeHierarchy::NodeAllocate()
+	{
+		if (m_free == node_null)
+		{
+			m_nodes.emplace_back();
+			return static_cast<uint32_t>(m_nodes.size() - 1);
+		}
+
+		const auto id	= m_free;
+		m_free			= m_nodes[id].parent;
+		m_nodes[id]		= Node();
+		return id;
+	}
+
+	void BoundingVolumeHierarchy::NodeFree(const uint32_t id)
+	{
+		m_nodes[id]			= Node();
+		m_nodes[id].parent	= m_free;
+		m_free				= id;
+	}
+
+	void BoundingVolumeHierarchy::LeafInsert(const uint32_t leaf)
+	{
+		if (m_root == node_null)
+		{
+			m_root					= leaf;
+			m_nodes[leaf].parent	= node_null;
+			return;
+		}
+
+		// Walk down, picking the child that grows the least
+		const BoundingBox leaf_box	= m_nodes[leaf].box;
+		uint32_t index				= m_root;
+		while (!m_nodes[index].IsLeaf())
+		{
+			const auto& node				= m_nodes[index];
+			const float area				= _BoundingVolumeHierarchy::Area(node.box);
+			const float area_combined		= _BoundingVolumeHierarchy::Area(_BoundingVolumeHierarchy::Merged(node.box, leaf_box));
+
+			// Cost of creating a new parent for this node and the new leaf
+			const float cost				= 2.0f * area_combined;
+			// Minimum cost of pushing the leaf further down the tree
+			const float cost_inheritance	= 2.0f * (area_combined - area);
+
+			auto cost_descend = [this, &leaf_box, cost_inheritance](const uint32_t child)
+			{
+				const auto& child_node	= m_nodes[child];
+				const float area_new	= _BoundingVolumeHierarchy::Area(_BoundingVolumeHierarchy::Merged(leaf_box, child_node.box));
+				return (child_node.IsLeaf() ? area_new : area_new - _BoundingVolumeHierarchy::Area(child_node.box)) + cost_inheritance;
+			};
+			const float cost_a = cost_descend(node.child_a);
+			const float cost_b = cost_descend(node.child_b);
+
+			if (cost < cost_a && cost < cost_b)
+				break;
+
+			index = cost_a < cost_b ? node.child_a : node.child_b;
+		}
+
+		// Create a new parent for the sibling and the leaf
+		const uint32_t sibling		= index;
+		const uint32_t parent_old	= m_nodes[sibling].parent;
+		const uint32_t parent_new	= NodeAllocate();
+		m_nodes[parent_new].parent	= parent_old;
+		m_nodes[parent_new].box		= _BoundingVolumeHierarchy::Merged(leaf_box, m_nodes[sibling].box);
+		m_nodes[parent_new].height	= m_nodes[sibling].height + 1;
+		m_nodes[parent_new].child_a	= sibling;
+		m_nodes[parent_new].child_b	= leaf;
+		m_nodes[sibling].parent		= parent_new;
+		m_nodes[leaf].parent		= parent_new;
+
+		if (parent_old != node_null)
+		{
+			if (m_nodes[parent_old].child_a == sibling)
+			{
+				m_nodes[parent_old].child_a = parent_new;
+			}
+			else
+			{
+				m_nodes[parent_old].child_b = parent_new;
+			}
+		}
+		else
+		{
+			m_root = parent_new;
+		}
+
+		Refit(m_nodes[leaf].parent);
+	}
+
+	void BoundingVolumeHierarchy::LeafRemove(const uint32_t leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = node_null;
+			return;
+		}
+
+		const uint32_t parent		= m_nodes[leaf].parent;
+		const uint32_t grandparent	= m_nodes[parent].parent;
+		const uint32_t sibling		= m_nodes[parent].child_a == leaf ? m_nodes[parent].child_b : m_nodes[parent].child_a;
+
+		// The sibling takes the place of the parent
+		if (grandparent != node_null)
+		{
+			if (m_nodes[grandparent].child_a == parent)
+			{
+				m_nodes[grandparent].child_a = sibling;
+			}
+			else
+			{
+				m_nodes[grandparent].child_b = sibling;
+			}
+			m_nodes[sibling].parent = grandparent;
+			NodeFree(parent);
+
+			Refit(grandparent);
+		}
+		else
+		{
+			m_root					= sibling;
+			m_nodes[sibling].parent	= node_null;
+			NodeFree(parent);
+		}
+
+		m_nodes[leaf].parent = node_null;
+	}
+
+	void BoundingVolumeHierarchy::Refit(uint32_t id)
+	{
+		while (id != node_null)
+		{
+			id = Balance(id);
+
+			auto& node			= m_nodes[id];
+			const auto& child_a	= m_nodes[node.child_a];
+			const auto& child_b	= m_nodes[node.child_b];
+			node.height			= 1 + Helper::Max(child_a.height, child_b.height);
+			node.box			= _BoundingVolumeHierarchy::Merged(child_a.box, child_b.box);
+
+			id = node.parent;
+		}
+	}
+
+	// Performs a left or right rotation if the node is imbalanced, returns the node that took its place
+	uint32_t BoundingVolumeHierarchy::Balance(const uint32_t id_a)
+	{
+		auto& a = m_nodes[id_a];
+		if (a.IsLeaf() || a.height < 2)
+			return id_a;
+
+		const uint32_t id_b	= a.child_a;
+		const uint32_t id_c	= a.child_b;
+		auto& b				= m_nodes[id_b];
+		auto& c				= m_nodes[id_c];
+		const int32_t balance = c.height - b.height;
+
+		// Points the parent of "from" to "to"
+		auto replace_in_parent = [this](const uint32_t parent, const uint32_t from, const uint32_t to)
+		{
+			if (parent == node_null)
+			{
+				m_root = to;
+			}
+			else if (m_nodes[parent].child_a == from)
+			{
+				m_nodes[parent].child_a = to;
+			}
+			else
+			{
+				m_nodes[parent].child_b = to;
+			}
+		};
+
+		// Rotate C up
+		if (balance > 1)
+		{
+			const uint32_t id_f	= c.child_a;
+			const uint32_t id_g	= c.child_b;
+			auto& f				= m_nodes[id_f];
+			auto& g				= m_nodes[id_g];
+
+			c.child_a	= id_a;
+			c.parent	= a.parent;
+			a.parent	= id_c;
+			replace_in_parent(c.parent, id_a, id_c);
+
+			if (f.height > g.height)
+			{
+				c.child_b	= id_f;
+				a.child_b	= id_g;
+				g.parent	= id_a;
+				a.box		= _BoundingVolumeHierarchy::Merged(b.box, g.box);
+				c.box		= _BoundingVolumeHierarchy::Merged(a.box, f.box);
+				a.height	= 1 + Helper::Max(b.height, g.height);
+				c.height	= 1 + Helper::Max(a.height, f.height);
+			}
+			else
+			{
+				c.child_b	= id_g;
+				a.child_b	= id_f;
+				f.parent	= id_a;
+				a.box		= _BoundingVolumeHierarchy::Merged(b.box, f.box);
+				c.box		= _BoundingVolumeHierarchy::Merged(a.box, g.box);
+				a.height	= 1 + Helper::Max(b.height, f.height);
+				c.height	= 1 + Helper::Max(a.height, g.height);
+			}
+
+			return id_c;
+		}
+
+		// Rotate B up
+		if (balance < -1)
+		{
+			const uint32_t id_d	= b.child_a;
+			const uint32_t id_e	= b.child_b;
+			auto& d				= m_nodes[id_d];
+			auto& e				= m_nodes[id_e];
+
+			b.child_a	= id_a;
+			b.parent	= a.parent;
+			a.parent	= id_b;
+			replace_in_parent(b.parent, id_a, id_b);
+
+			if (d.height > e.height)
+			{
+				b.child_b	= id_d;
+				a.child_a	= id_e;
+				e.parent	= id_a;
+				a.box		= _BoundingVolumeHierarchy::Merged(c.box, e.box);
+				b.box		= _BoundingVolumeHierarchy::Merged(a.box, d.box);
+				a.height	= 1 + Helper::Max(c.height, e.height);
+				b.height	= 1 + Helper::Max(a.height, d.height);
+			}
+			else
+			{
+				b.child_b	= id_e;
+				a.child_a	= id_d;
+				d.parent	= id_a;
+				a.box		= _BoundingVolumeHierarchy::Merged(c.box, d.box);
+				b.box		= _BoundingVolumeHierarchy::Merged(a.box, e.box);
+				a.height	= 1 + Helper::Max(c.height, d.height);
+				b.height	= 1 + Helper::Max(a.height, e.height);
+			}
+
+			return id_b;
+		}
+
+		return id_a;
+	}
+}
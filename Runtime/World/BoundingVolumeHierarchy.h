@@ -0,0 +1,196 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =====================
+#include <vector>
+#include "../Core/EngineDefs.h"
+#include "../Math/BoundingBox.h"
+#include "../Math/Frustum.h"
+#include "../Math/Ray.h"
+//================================
+
+namespace Spartan
+{
+	class Entity;
+
+	// Dynamic bounding volume hierarchy of entity boxes. Leaves store enlarged boxes so that small
+	// movements don't touch the tree, and the tree is kept balanced with rotations as leaves come and go.
+	class SPARTAN_CLASS BoundingVolumeHierarchy
+	{
+	public:
+		static const uint32_t node_null = ~0U;
+
+		// Adds a leaf and returns its id
+		uint32_t Insert(const Math::BoundingBox& box, Entity* entity);
+		void Remove(uint32_t id);
+		// Returns true if the leaf had to be re-inserted, which happens when the box leaves the enlarged box of the leaf
+		bool Move(uint32_t id, const Math::BoundingBox& box);
+		void Clear();
+
+		Entity* GetEntity(const uint32_t id) const			{ return m_nodes[id].entity; }
+		const Math::BoundingBox& GetBox(const uint32_t id) const	{ return m_nodes[id].box; }
+		uint32_t GetLeafCount() const						{ return m_leaf_count; }
+		uint32_t GetHeight() const							{ return m_root == node_null ? 0 : static_cast<uint32_t>(m_nodes[m_root].height); }
+
+		//= QUERIES ==========================================================================================
+		// All of them call function(Entity*) for every leaf whose enlarged box passes the test
+
+		template <typename Function>
+		void QueryBox(const Math::BoundingBox& box, Function&& function) const
+		{
+			Query([&box](const Math::BoundingBox& node_box) { return box.IsInside(node_box) != Math::Helper::Outside; }, function);
+		}
+
+		template <typename Function>
+		void QuerySphere(const Math::Vector3& center, const float radius, Function&& function) const
+		{
+			Query([&center, radius](const Math::BoundingBox& node_box)
+			{
+				// Squared distance from the center to the box
+				const Math::Vector3& min	= node_box.GetMin();
+				const Math::Vector3& max	= node_box.GetMax();
+				const float dx				= Math::Helper::Max(Math::Helper::Max(min.x - center.x, 0.0f), center.x - max.x);
+				const float dy				= Math::Helper::Max(Math::Helper::Max(min.y - center.y, 0.0f), center.y - max.y);
+				const float dz				= Math::Helper::Max(Math::Helper::Max(min.z - center.z, 0.0f), center.z - max.z);
+				return dx * dx + dy * dy + dz * dz <= radius * radius;
+			}, function);
+		}
+
+		template <typename Function>
+		void QueryRay(const Math::Ray& ray, Function&& function) const
+		{
+			Query([&ray](const Math::BoundingBox& node_box) { return ray.HitDistance(node_box) != INFINITY; }, function);
+		}
+
+		template <typename Function>
+		void QueryFrustum(const Math::Frustum& frustum, Function&& function) const
+		{
+			if (m_root == node_null)
+				return;
+
+			std::vector<uint32_t> stack = { m_root };
+			while (!stack.empty())
+			{
+				const auto& node = m_nodes[stack.back()];
+				stack.pop_back();
+
+				const auto result = frustum.CheckCube(node.box.GetCenter(), node.box.GetExtents());
+				if (result == Math::Helper::Outside)
+					continue;
+
+				// Fully inside, everything below is visible
+				if (result == Math::Helper::Inside)
+				{
+					ForEachLeaf(&node - m_nodes.data(), function);
+					continue;
+				}
+
+				if (node.IsLeaf())
+				{
+					function(node.entity);
+					continue;
+				}
+
+				stack.emplace_back(node.child_a);
+				stack.emplace_back(node.child_b);
+			}
+		}
+		//====================================================================================================
+
+	private:
+		struct Node
+		{
+			bool IsLeaf() const { return child_a == node_null; }
+
+			Math::BoundingBox box;
+			Entity* entity		= nullptr;
+			// Parent while in the tree, next free node while in the free list
+			uint32_t parent		= node_null;
+			uint32_t child_a	= node_null;
+			uint32_t child_b	= node_null;
+			// Leaves have a height of 0, free nodes -1
+			int32_t height		= -1;
+		};
+
+		template <typename Overlaps, typename Function>
+		void Query(Overlaps&& overlaps, Function&& function) const
+		{
+			if (m_root == node_null)
+				return;
+
+			std::vector<uint32_t> stack = { m_root };
+			while (!stack.empty())
+			{
+				const auto& node = m_nodes[stack.back()];
+				stack.pop_back();
+
+				if (!overlaps(node.box))
+					continue;
+
+				if (node.IsLeaf())
+				{
+					function(node.entity);
+				}
+				else
+				{
+					stack.emplace_back(node.child_a);
+					stack.emplace_back(node.child_b);
+				}
+			}
+		}
+
+		template <typename Function>
+		void ForEachLeaf(const size_t id, Function&& function) const
+		{
+			std::vector<uint32_t> stack = { static_cast<uint32_t>(id) };
+			while (!stack.empty())
+			{
+				const auto& node = m_nodes[stack.back()];
+				stack.pop_back();
+
+				if (node.IsLeaf())
+				{
+					function(node.entity);
+				}
+				else
+				{
+					stack.emplace_back(node.child_a);
+					stack.emplace_back(node.child_b);
+				}
+			}
+		}
+
+		uint32_t NodeAllocate();
+		void NodeFree(uint32_t id);
+		void LeafInsert(uint32_t leaf);
+		void LeafRemove(uint32_t leaf);
+		uint32_t Balance(uint32_t id);
+		// Recomputes boxes and heights from id up to the root, balancing along the way
+		void Refit(uint32_t id);
+
+		std::vector<Node> m_nodes;
+		uint32_t m_root			= node_null;
+		uint32_t m_free			= node_null;
+		uint32_t m_leaf_count	= 0;
+	};
+}
@@ -0,0 +1,125 @@
+/*
+Copyright(c) 2016-2019 Panos Karabelas
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is furnished
+to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+//= INCLUDES =========
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <array>
+#include <utility>
+#include "IComponent.h"
+//====================
+
+namespace Spartan
+{
+	/*
+	Components of the same type are allocated next to each other, in chunks that never move
+	(components capture "this" in their attributes, so they must keep their address).
+	Ownership still goes through std::shared_ptr, the deleter returns the slot to the pool
+	and keeps the pool alive, so components can safely outlive the context which owns it.
+	*/
+	template <class T>
+	class ComponentPool : public std::enable_shared_from_this<ComponentPool<T>>
+	{
+	public:
+		template <class... Args>
+		std::shared_ptr<T> Create(Args&&... args)
+		{
+			// Reserve a slot
+			uint32_t index = 0;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (m_free.empty())
+				{
+					m_chunks.emplace_back(std::make_unique<Chunk>());
+					const auto first = static_cast<uint32_t>((m_chunks.size() - 1) * chunk_size);
+					for (uint32_t i = chunk_size; i > 0; i--)
+					{
+						m_free.emplace_back(first + i - 1);
+					}
+				}
+				index = m_free.back();
+				m_free.pop_back();
+			}
+
+			// Construct outside of the lock, constructors are free to create other components
+			T* component = new (&GetChunk(index).storage[index % chunk_size]) T(std::forward<Args>(args)...);
+
+			return std::shared_ptr<T>(component, [index, pool = this->shared_from_this()](T* component)
+			{
+				component->~T();
+				pool->Free(index);
+			});
+		}
+
+		uint32_t GetCount()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return static_cast<uint32_t>(m_chunks.size() * chunk_size - m_free.size());
+		}
+
+	private:
+		static const uint32_t chunk_size = 64;
+
+		struct Chunk
+		{
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type storage[chunk_size];
+		};
+
+		Chunk& GetChunk(const uint32_t index) { return *m_chunks[index / chunk_size]; }
+
+		void Free(const uint32_t index)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_free.emplace_back(index);
+		}
+
+		std::vector<std::unique_ptr<Chunk>> m_chunks;
+		std::vector<uint32_t> m_free;
+		std::mutex m_mutex;
+	};
+
+	// One pool per component type, owned by the Context
+	class ComponentPools
+	{
+	public:
+		template <class T>
+		ComponentPool<T>* Get()
+		{
+			const ComponentType type = IComponent::TypeToEnum<T>();
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto& pool = m_pools[type];
+			if (!pool)
+			{
+				pool = std::make_shared<ComponentPool<T>>();
+			}
+
+			return static_cast<ComponentPool<T>*>(pool.get());
+		}
+
+	private:
+		std::array<std::shared_ptr<void>, ComponentType_Unknown> m_pools;
+		std::mutex m_mutex;
+	};
+}
@@ -54,7 +54,7 @@ namespace Spartan
 		m_errorReduction			= 0.0f;
 		m_constraintForceMixing		= 0.0f;
 		m_constraintType			= ConstraintType_Point;
-		m_physics					= GetContext()->GetSubsystem<Physics>().get();
+		m_physics					= GetContext()->GetSubsystem<Physics>();
 
 		REGISTER_ATTRIBUTE_VALUE_VALUE(m_errorReduction, float);
 		REGISTER_ATTRIBUTE_VALUE_VALUE(m_constraintForceMixing, float);
@@ -49,7 +49,7 @@ namespace Spartan
 		REGISTER_ATTRIBUTE_GET_SET(GetLightType, SetLightType, LightType);
 
 		m_color		= Vector4(1.0f, 0.76f, 0.57f, 1.0f);
-		m_renderer	= m_context->GetSubsystem<Renderer>().get();
+		m_renderer	= m_context->GetSubsystem<Renderer>();
 	}
 
 	Light::~Light()
@@ -306,15 +306,21 @@ namespace Spartan
 
 		if (GetLightType() == LightType_Directional)
 		{
-			m_shadow_map = make_unique<RHI_Texture2D>(m_context, resolution, resolution, Format_D32_FLOAT, 3);
+			m_shadow_map		= make_unique<RHI_Texture2D>(m_context, resolution, resolution, Format_D32_FLOAT, 3);
+			m_shadow_map_static	= make_unique<RHI_Texture2D>(m_context, resolution, resolution, Format_D32_FLOAT, 3);
 		}
 		else if (GetLightType() == LightType_Point)
 		{
-			m_shadow_map = make_unique<RHI_TextureCube>(m_context, resolution, resolution, Format_D32_FLOAT);			
+			m_shadow_map		= make_unique<RHI_TextureCube>(m_context, resolution, resolution, Format_D32_FLOAT);
+			m_shadow_map_static	= make_unique<RHI_TextureCube>(m_context, resolution, resolution, Format_D32_FLOAT);
 		}
 		else if (GetLightType() == LightType_Spot)
 		{
-			m_shadow_map = make_unique<RHI_Texture2D>(m_context, resolution, resolution, Format_D32_FLOAT, 1);
+			m_shadow_map		= make_unique<RHI_Texture2D>(m_context, resolution, resolution, Format_D32_FLOAT, 1);
+			m_shadow_map_static	= make_unique<RHI_Texture2D>(m_context, resolution, resolution, Format_D32_FLOAT, 1);
 		}
+
+		// New textures, nothing is cached
+		m_shadow_cache.fill(LightShadowCache());
 	}
 }  
\ No newline at end of file
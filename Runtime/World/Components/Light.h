@@ -49,6 +49,14 @@ namespace Spartan
 		LightType_Spot
 	};
 
+	// What the static caster cache of a shadow map slice was rendered with
+	struct LightShadowCache
+	{
+		Math::Matrix view_projection;
+		uint64_t caster_signature	= 0;	// the static casters it holds, zero means it was never rendered
+		bool has_dynamic			= true;	// the shadow map slice holds more than the cache
+	};
+
 	class SPARTAN_CLASS Light : public IComponent
 	{
 	public:
@@ -94,7 +102,9 @@ namespace Spartan
 		const Math::Matrix& GetViewMatrix(uint32_t index = 0);
 		const Math::Matrix& GetProjectionMatrix(uint32_t index = 0);
 
-		const auto& GetShadowMap() { return m_shadow_map; }
+		const auto& GetShadowMap()							{ return m_shadow_map; }
+		const auto& GetShadowMapStatic()					{ return m_shadow_map_static; }
+		LightShadowCache& GetShadowCache(uint32_t index)	{ return m_shadow_cache[index]; }
 
 	private:
 		void ComputeViewMatrix();
@@ -117,7 +127,10 @@ namespace Spartan
 		Math::Vector3 m_lastPosCamera;
 		
 		// Shadow map
-		std::shared_ptr<RHI_Texture> m_shadow_map;	
+		std::shared_ptr<RHI_Texture> m_shadow_map;
+		// Static casters only, copied into the shadow map before the dynamic casters are drawn
+		std::shared_ptr<RHI_Texture> m_shadow_map_static;
+		std::array<LightShadowCache, 6> m_shadow_cache;
 		Renderer* m_renderer;
 	};
 }
\ No newline at end of file
@@ -27,6 +27,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Rendering/Utilities/Geometry.h"
 #include "../../Rendering/Material.h"
 #include "../../Rendering/Model.h"
+#include "../World.h"
 //=============================================
 
 //= NAMESPACES ================
@@ -142,6 +143,7 @@ namespace Spartan
 		m_geometryVertexOffset	= stream->ReadAs<uint32_t>();
 		m_geometryVertexCount	= stream->ReadAs<uint32_t>();
 		stream->Read(&m_geometryAABB);
+		m_aabb_world_dirty = true;
 		string model_name;
 		stream->Read(&model_name);
 		m_model = m_context->GetSubsystem<ResourceCache>()->GetByName<Model>(model_name);
@@ -178,6 +180,7 @@ namespace Spartan
 		m_geometryVertexOffset	= vertex_offset;
 		m_geometryVertexCount	= vertex_count;
 		m_geometryAABB			= aabb;
+		m_aabb_world_dirty		= true;
 		m_model					= model;
 	}
 
@@ -202,9 +205,17 @@ namespace Spartan
 		m_model->GeometryGet(m_geometryIndexOffset, m_geometryIndexCount, m_geometryVertexOffset, m_geometryVertexCount, indices, vertices);
 	}
 
-	BoundingBox Renderable::GeometryAabb()
+	const BoundingBox& Renderable::GeometryAabb()
 	{
-		return m_geometryAABB.Transformed(GetTransform()->GetMatrix());
+		const auto& matrix = GetTransform()->GetMatrix();
+		if (m_aabb_world_dirty || m_aabb_world_version != GetTransform()->GetVersion())
+		{
+			m_aabb_world			= m_geometryAABB.Transformed(matrix);
+			m_aabb_world_version	= GetTransform()->GetVersion();
+			m_aabb_world_dirty		= false;
+		}
+
+		return m_aabb_world;
 	}
 	//==============================================================================
 
@@ -218,6 +229,12 @@ namespace Spartan
 			return;
 		}
 		m_material = material;
+
+		// Opaque and transparent renderables are drawn by different passes
+		if (auto world = GetContext()->GetSubsystem<World>())
+		{
+			world->EntityOnChanged(GetEntity_PtrRaw());
+		}
 	}
 
 	shared_ptr<Material> Renderable::MaterialSet(const string& file_path)
@@ -78,8 +78,10 @@ namespace Spartan
 		Geometry_Type GeometryType() const				{ return m_geometry_type; }
 		const std::string& GeometryName() const			{ return m_geometryName; }
 		std::shared_ptr<Model> GeometryModel() const	{ return m_model; }
+		Model* GeometryModel_PtrRaw() const				{ return m_model.get(); }
 		const Math::BoundingBox& GeometryAabb() const	{ return m_geometryAABB; }
-		Math::BoundingBox GeometryAabb();
+		// World space bounding box, only recomputed when the transform or the geometry changes
+		const Math::BoundingBox& GeometryAabb();
 		//========================================================================================================
 
 		//= MATERIAL ============================================================
@@ -92,6 +94,7 @@ namespace Spartan
 		void MaterialUseDefault();
 		const std::string& MaterialName();
 		auto MaterialPtr() const	{ return m_material; }
+		auto Material_PtrRaw() const	{ return m_material.get(); }
 		bool MaterialExists() const { return m_material != nullptr; }
 		//=======================================================================
 
@@ -110,6 +113,9 @@ namespace Spartan
 		uint32_t m_geometryVertexOffset;
 		uint32_t m_geometryVertexCount;
 		Math::BoundingBox m_geometryAABB;
+		Math::BoundingBox m_aabb_world;
+		uint32_t m_aabb_world_version	= 0;
+		bool m_aabb_world_dirty			= true;
 		std::shared_ptr<Model> m_model;
 		Geometry_Type m_geometry_type;
 		//==================================
@@ -91,7 +91,7 @@ namespace Spartan
 		m_hasSimulated		= false;
 		m_positionLock		= Vector3::Zero;
 		m_rotationLock		= Vector3::Zero;
-		m_physics			= GetContext()->GetSubsystem<Physics>().get();
+		m_physics			= GetContext()->GetSubsystem<Physics>();
 		m_collisionShape	= nullptr;
 		m_rigidBody			= nullptr;
 
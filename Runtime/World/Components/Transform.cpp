@@ -26,7 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../../Core/Context.h"
 #include "../../IO/FileStream.h"
 #include "../../FileSystem/FileSystem.h"
-#include "../../RHI/RHI_ConstantBuffer.h"
+#include "../../RHI/RHI_Vertex.h"
 //=======================================
 
 //= NAMESPACES ================
@@ -90,25 +90,45 @@ namespace Spartan
 	}
 	//===============================================================================================
 	void Transform::UpdateTransform()
+	{
+		MarkDirty(true);
+	}
+
+	void Transform::MarkDirty(const bool force /*= false*/)
+	{
+		// Descendants of a dirty transform are already dirty
+		if (m_dirty && !force)
+			return;
+
+		m_dirty				= true;
+		m_dirty_inverted	= true;
+
+		for (const auto& child : m_children)
+		{
+			child->MarkDirty(force);
+		}
+	}
+
+	void Transform::ComputeMatrix()
 	{
 		// Compute local transform
 		m_matrixLocal = Matrix(m_positionLocal, m_rotationLocal, m_scaleLocal);
 
 		// Compute world transform
-		if (!HasParent())
-		{
-			m_matrix = m_matrixLocal;
-		}
-		else
-		{
-			m_matrix = m_matrixLocal * GetParentTransformMatrix();
-		}
-		
-		// Update children
-		for (const auto& child : m_children)
+		m_matrix	= HasParent() ? m_matrixLocal * m_parent->GetMatrix() : m_matrixLocal;
+		m_dirty		= false;
+		m_version++;
+	}
+
+	const Matrix& Transform::GetMatrixInverted()
+	{
+		if (m_dirty || m_dirty_inverted)
 		{
-			child->UpdateTransform();
+			m_matrix_inverted	= GetMatrix().Inverted();
+			m_dirty_inverted	= false;
 		}
+
+		return m_matrix_inverted;
 	}
 
 	//= TRANSLATION ==================================================================================
@@ -117,7 +137,7 @@ namespace Spartan
 		if (GetPosition() == position)
 			return;
 
-		SetPositionLocal(!HasParent() ? position : position * GetParent()->GetMatrix().Inverted());
+		SetPositionLocal(!HasParent() ? position : position * GetParent()->GetMatrixInverted());
 	}
 
 	void Transform::SetPositionLocal(const Vector3& position)
@@ -126,7 +146,7 @@ namespace Spartan
 			return;
 
 		m_positionLocal = position;
-		UpdateTransform();
+		MarkDirty();
 	}
 	//================================================================================================
 
@@ -145,7 +165,7 @@ namespace Spartan
 			return;
 
 		m_rotationLocal = rotation;
-		UpdateTransform();
+		MarkDirty();
 	}
 	//================================================================================================
 
@@ -171,7 +191,7 @@ namespace Spartan
 		m_scaleLocal.y = (m_scaleLocal.y == 0.0f) ? M_EPSILON : m_scaleLocal.y;
 		m_scaleLocal.z = (m_scaleLocal.z == 0.0f) ? M_EPSILON : m_scaleLocal.z;
 
-		UpdateTransform();
+		MarkDirty();
 	}
 	//================================================================================================
 
@@ -184,7 +204,7 @@ namespace Spartan
 		}
 		else
 		{
-			SetPositionLocal(m_positionLocal + GetParent()->GetMatrix().Inverted() * delta);
+			SetPositionLocal(m_positionLocal + GetParent()->GetMatrixInverted() * delta);
 		}
 	}
 
@@ -275,6 +295,9 @@ namespace Spartan
 		}
 
 		UpdateTransform();
+
+		// The world keeps a depth ordered copy of the hierarchy
+		FIRE_EVENT(Event_World_Resolve);
 	}
 
 	void Transform::AddChild(Transform* child)
@@ -325,7 +348,7 @@ namespace Spartan
 		m_children.clear();
 		m_children.shrink_to_fit();
 
-		auto entities = GetContext()->GetSubsystem<World>()->EntityGetAll();
+		const auto& entities = GetContext()->GetSubsystem<World>()->EntityGetAll();
 		for (const auto& entity : entities)
 		{
 			if (!entity)
@@ -343,6 +366,10 @@ namespace Spartan
 			{
 				// welcome home son
 				m_children.emplace_back(possible_child);
+				if (m_dirty)
+				{
+					possible_child->MarkDirty(true);
+				}
 
 				// make the child do the same thing all over, essentialy
 				// resolving the entire hierarchy.
@@ -375,64 +402,17 @@ namespace Spartan
 		}
 	}
 
-	void Transform::UpdateConstantBuffer(const shared_ptr<RHI_Device>& rhi_device, const Matrix& view_projection)
-	{
-		// Has to match GBuffer.hlsl
-		if (!m_cb_gbuffer_gpu)
-		{
-			m_cb_gbuffer_gpu = make_shared<RHI_ConstantBuffer>(rhi_device);
-			m_cb_gbuffer_gpu->Create<CB_Gbuffer>();
-		}
-
-		auto mvp_current = m_matrix * view_projection;
-	
-		// Determine if the buffer needs to update
-		auto update	= false;
-		update				= m_cb_gbuffer_cpu.model		!= m_matrix	? true : update;
-		bool new_input		= m_cb_gbuffer_cpu.mvp_current	!= mvp_current;
-		bool non_zero_delta = m_cb_gbuffer_cpu.mvp_current	!= m_cb_gbuffer_cpu.mvp_previous;
-		update				= new_input || non_zero_delta ? true : update;
-		if (!update)
-			return;
-
-		// Update buffer
-		auto buffer = static_cast<CB_Gbuffer*>(m_cb_gbuffer_gpu->Map());
-
-		buffer->model			= m_cb_gbuffer_cpu.model		= m_matrix;
-		buffer->mvp_current		= m_cb_gbuffer_cpu.mvp_current	= mvp_current;
-		buffer->mvp_previous	= m_cb_gbuffer_cpu.mvp_previous	= m_wvp_previous;
-
-		m_cb_gbuffer_gpu->Unmap();
-
-		m_wvp_previous = mvp_current;
-	}
-
-	void Transform::UpdateConstantBufferLight(const shared_ptr<RHI_Device>& rhi_device, const Matrix& view_projection, uint32_t cascade_index)
+	void Transform::UpdateInstance(const Matrix& view_projection, RHI_Instance_TransformHistory* instance)
 	{
 		// Has to match GBuffer.hlsl
-		if (cascade_index >=  static_cast<uint32_t>(m_light_cascades.size()))
-		{
-			LightCascade cb_light;
-			cb_light.buffer = make_shared<RHI_ConstantBuffer>(rhi_device);
-			cb_light.buffer->Create<Matrix>();
-			m_light_cascades.emplace_back(cb_light);
-		}
-		auto& cb_light = m_light_cascades[cascade_index];
-
-		// Determine if the buffer needs to update
-		auto mvp = m_matrix * view_projection;
-		if (cb_light.data == mvp)
-			return;
+		const auto& matrix		= GetMatrix();
+		const auto wvp_current	= matrix * view_projection;
 
-		// Update buffer
-		Matrix& data = *static_cast<Matrix*>(cb_light.buffer->Map());
-		data = mvp;
-		cb_light.buffer->Unmap();
-	}
+		instance->world			= matrix;
+		instance->wvp_current	= wvp_current;
+		instance->wvp_previous	= m_wvp_previous;
 
-	Matrix Transform::GetParentTransformMatrix() const
-	{
-		return HasParent() ? GetParent()->GetMatrix() : Matrix::Identity;
+		m_wvp_previous = wvp_current;
 	}
 
 	// Makes this transform have no parent
@@ -458,5 +438,8 @@ namespace Spartan
 		{
 			temp_ref->AcquireChildren();
 		}
+
+		// The world keeps a depth ordered copy of the hierarchy
+		FIRE_EVENT(Event_World_Resolve);
 	}
 }
\ No newline at end of file
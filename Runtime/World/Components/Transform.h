@@ -32,8 +32,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace Spartan
 {
-	class RHI_Device;
-	class RHI_ConstantBuffer;
+	struct RHI_Instance_TransformHistory;
 
 	class SPARTAN_CLASS Transform : public IComponent
 	{
@@ -47,24 +46,28 @@ namespace Spartan
 		void Deserialize(FileStream* stream) override;
 		//============================================
 
+		// Marks the world matrix of this transform and its descendants as stale, it will be recomputed when next requested
 		void UpdateTransform();
+		bool IsDirty() const { return m_dirty; }
+		// Changes every time the world matrix is recomputed, lets dependent data know when to refresh
+		uint32_t GetVersion() const { return m_version; }
 
 		//= POSITION ========================================================================
-		Math::Vector3 GetPosition()						{ return m_matrix.GetTranslation(); }
+		Math::Vector3 GetPosition()						{ return GetMatrix().GetTranslation(); }
 		const Math::Vector3& GetPositionLocal() const	{ return m_positionLocal; }
 		void SetPosition(const Math::Vector3& position);
 		void SetPositionLocal(const Math::Vector3& position);
 		//===================================================================================
 
 		//= ROTATION =========================================================================
-		Math::Quaternion GetRotation()						{ return m_matrix.GetRotation(); }
+		Math::Quaternion GetRotation()						{ return GetMatrix().GetRotation(); }
 		const Math::Quaternion& GetRotationLocal() const	{ return m_rotationLocal; }
 		void SetRotation(const Math::Quaternion& rotation);
 		void SetRotationLocal(const Math::Quaternion& rotation);
 		//====================================================================================
 
 		//= SCALE =================================================================
-		Math::Vector3 GetScale()					{ return m_matrix.GetScale(); }
+		Math::Vector3 GetScale()					{ return GetMatrix().GetScale(); }
 		const Math::Vector3& GetScaleLocal() const	{ return m_scaleLocal; }
 		void SetScale(const Math::Vector3& scale);
 		void SetScaleLocal(const Math::Vector3& scale);
@@ -101,18 +104,18 @@ namespace Spartan
 		//==============================================================================================
 
 		void LookAt(const Math::Vector3& v) { m_lookAt = v; }
-		Math::Matrix& GetMatrix()			{ return m_matrix; }
-		Math::Matrix& GetLocalMatrix()		{ return m_matrixLocal; }
+		const Math::Matrix& GetMatrix()			{ if (m_dirty) ComputeMatrix(); return m_matrix; }
+		const Math::Matrix& GetLocalMatrix()	{ if (m_dirty) ComputeMatrix(); return m_matrixLocal; }
+		const Math::Matrix& GetMatrixInverted();
 
-		//= CONSTANT BUFFERS ==========================================================================================================================
-		void UpdateConstantBuffer(const std::shared_ptr<RHI_Device>& rhi_device, const Math::Matrix& view_projection);
-		const auto& GetConstantBuffer() { return m_cb_gbuffer_gpu; }
-		void UpdateConstantBufferLight(const std::shared_ptr<RHI_Device>& rhi_device, const Math::Matrix& view_projection, uint32_t cascade_index);
-		const auto& GetConstantBufferLight(uint32_t cascade_index) { return m_light_cascades[cascade_index].buffer; }
-		//=============================================================================================================================================
+		// Fills the instance data of the G-buffer pass, expected once per frame as it also remembers this frame's transform for velocity
+		void UpdateInstance(const Math::Matrix& view_projection, RHI_Instance_TransformHistory* instance);
 
 	private:
-		Math::Matrix GetParentTransformMatrix() const;
+		// Recomputes the local and world matrices, expects the parent (if any) to be resolvable
+		void ComputeMatrix();
+		// Marks this transform and its descendants as dirty, stops at transforms that are already dirty
+		void MarkDirty(bool force = false);
 
 		// local
 		Math::Vector3 m_positionLocal;
@@ -121,28 +124,19 @@ namespace Spartan
 
 		Math::Matrix m_matrix;
 		Math::Matrix m_matrixLocal;
+		Math::Matrix m_matrix_inverted;
 		Math::Vector3 m_lookAt;
 
+		// World matrix needs to be recomputed (a dirty transform always has dirty descendants)
+		bool m_dirty			= true;
+		// Inverted world matrix needs to be recomputed
+		bool m_dirty_inverted	= true;
+		uint32_t m_version		= 0;
+
 		Transform* m_parent; // the parent of this transform
 		std::vector<Transform*> m_children; // the children of this transform
 
-		// Constant buffer
-		struct CB_Gbuffer
-		{
-			Math::Matrix model;
-			Math::Matrix mvp_current;
-			Math::Matrix mvp_previous;
-		};
-		CB_Gbuffer m_cb_gbuffer_cpu;
-		std::shared_ptr<RHI_ConstantBuffer> m_cb_gbuffer_gpu;
+		// The world view projection of the previous frame
 		Math::Matrix m_wvp_previous;
-
-		// Constant buffer
-		struct LightCascade
-		{
-			Math::Matrix data;
-			std::shared_ptr<RHI_ConstantBuffer> buffer;
-		};
-		std::vector<LightCascade> m_light_cascades;
 	};
 }
\ No newline at end of file
@@ -58,9 +58,11 @@ namespace Spartan
 		// delete components
 		for (auto it = m_components.begin(); it != m_components.end();)
 		{
+			const ComponentType type = (*it)->GetType();
 			(*it)->OnRemove();
 			(*it).reset();
 			it = m_components.erase(it);
+			UpdateComponentSlot(type);
 		}
 		m_components.clear();
 
@@ -70,6 +72,36 @@ namespace Spartan
 		m_hierarchy_visibility	= true;
 	}
 
+	void Entity::SetName(const string& name)
+	{
+		if (name == m_name)
+			return;
+
+		const auto name_previous = m_name;
+		m_name = name;
+
+		// Keep the world's lookup tables in sync
+		if (auto world = m_context->GetSubsystem<World>())
+		{
+			world->EntityOnRenamed(this, name_previous);
+		}
+	}
+
+	void Entity::SetId(const uint32_t id)
+	{
+		if (id == m_id)
+			return;
+
+		const auto id_previous = m_id;
+		m_id = id;
+
+		// Keep the world's lookup tables in sync
+		if (auto world = m_context->GetSubsystem<World>())
+		{
+			world->EntityOnIdChanged(this, id_previous);
+		}
+	}
+
 	void Entity::Initialize(Transform* transform)
 	{
 		m_transform = transform;
@@ -210,8 +242,8 @@ namespace Spartan
 		//= BASIC DATA =====================
 		stream->Read(&m_is_active);
 		stream->Read(&m_hierarchy_visibility);
-		stream->Read(&m_id);
-		stream->Read(&m_name);
+		SetId(stream->ReadAs<uint32_t>());
+		SetName(stream->ReadAs<string>());
 		//==================================
 
 		//= COMPONENTS ================================
@@ -307,9 +339,11 @@ namespace Spartan
 			auto component = *it;
 			if (id == component->GetID())
 			{
+				const ComponentType type = component->GetType();
 				component->OnRemove();
 				component.reset();
 				it = m_components.erase(it);
+				UpdateComponentSlot(type);
 			}
 			else
 			{
@@ -318,6 +352,38 @@ namespace Spartan
 		}
 
 		// Make the scene resolve
+		OnComponentsChanged();
+	}
+
+	void Entity::OnComponentsChanged()
+	{
+		if (auto world = m_context->GetSubsystem<World>())
+		{
+			world->EntityOnChanged(this);
+		}
+
 		FIRE_EVENT(Event_World_Resolve);
 	}
+
+	void Entity::UpdateComponentSlot(const ComponentType type)
+	{
+		if (type >= ComponentType_Unknown)
+			return;
+
+		m_component_slots[type] = nullptr;
+		for (const auto& component : m_components)
+		{
+			if (component->GetType() == type)
+			{
+				m_component_slots[type] = component;
+				break;
+			}
+		}
+
+		// Keep the cached renderable in sync, so that it reads null once it's removed
+		if (type == ComponentType_Renderable)
+		{
+			m_renderable = static_cast<Renderable*>(m_component_slots[type].get());
+		}
+	}
 }
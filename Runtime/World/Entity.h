@@ -23,8 +23,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //= INCLUDES =====================
 #include <vector>
+#include <array>
 #include "Components/IComponent.h"
+#include "Components/ComponentPool.h"
 #include "../Core/EventSystem.h"
+#include "../Core/Context.h"
 //================================
 
 namespace Spartan
@@ -54,10 +57,10 @@ namespace Spartan
 
 		//= PROPERTIES ===================================================================================================
 		const std::string& GetName() const								{ return m_name; }
-		void SetName(const std::string& name)							{ m_name = name; }
+		void SetName(const std::string& name);
 
 		uint32_t GetId() const										{ return m_id; }
-		void SetId(const uint32_t id)								{ m_id = id; }
+		void SetId(uint32_t id);
 
 		bool IsActive() const											{ return m_is_active; }
 		void SetActive(const bool active)								{ m_is_active = active; }
@@ -80,19 +83,20 @@ namespace Spartan
 			if (HasComponent(type) && type != ComponentType_Script)
 				return GetComponent<T>();
 
-			// Add component
-			m_components.emplace_back
-			(	
-				std::make_shared<T>
-				(
-					m_context,
-					this,
-					GetTransform_PtrRaw()
-				)
+			// Add component (allocated next to the other components of the same type)
+			auto new_component = m_context->GetComponentPools()->Get<T>()->Create
+			(
+				m_context,
+				this,
+				GetTransform_PtrRaw()
 			);
+			m_components.emplace_back(new_component);
 
-			auto new_component = std::static_pointer_cast<T>(m_components.back());
-			new_component->SetType(IComponent::TypeToEnum<T>());
+			new_component->SetType(type);
+			if (!m_component_slots[type])
+			{
+				m_component_slots[type] = new_component;
+			}
 			new_component->OnInitialize();
 
 			// Caching of rendering performance critical components
@@ -102,7 +106,7 @@ namespace Spartan
 			}
 
 			// Make the scene resolve
-			FIRE_EVENT(Event_World_Resolve);
+			OnComponentsChanged();
 
 			return new_component;
 		}
@@ -114,13 +118,15 @@ namespace Spartan
 			VALIDATE_COMPONENT_TYPE(T);
 			const ComponentType type = IComponent::TypeToEnum<T>();
 
-			for (const auto& component : m_components)
-			{
-				if (component->GetType() == type)
-					return std::static_pointer_cast<T>(component);
-			}
+			return std::static_pointer_cast<T>(m_component_slots[type]);
+		}
 
-			return nullptr;
+		// Returns a component of type T (if it exists), without touching the reference count
+		template <class T>
+		constexpr T* GetComponent_PtrRaw() const
+		{
+			VALIDATE_COMPONENT_TYPE(T);
+			return static_cast<T*>(m_component_slots[IComponent::TypeToEnum<T>()].get());
 		}
 
 		// Returns any components of type T (if they exist)
@@ -143,20 +149,14 @@ namespace Spartan
 		}
 		
 		// Checks if a component of ComponentType exists
-		bool HasComponent(const ComponentType type) 
+		bool HasComponent(const ComponentType type) const
 		{ 
-			for (const auto& component : m_components)
-			{
-				if (component->GetType() == type)
-					return true;
-			}
-
-			return false;
+			return type < ComponentType_Unknown && m_component_slots[type] != nullptr;
 		}
 
 		// Checks if a component of type T exists
 		template <class T>
-		constexpr bool HasComponent() 
+		constexpr bool HasComponent() const
 		{ 
 			VALIDATE_COMPONENT_TYPE(T);
 			return HasComponent(IComponent::TypeToEnum<T>()); 
@@ -183,9 +183,10 @@ namespace Spartan
 					++it;
 				}
 			}
+			UpdateComponentSlot(type);
 
 			// Make the scene resolve
-			FIRE_EVENT(Event_World_Resolve);
+			OnComponentsChanged();
 		}
 
 		void RemoveComponentById(uint32_t id);
@@ -197,6 +198,11 @@ namespace Spartan
 		std::shared_ptr<Entity> GetPtrShared()		{ return shared_from_this(); }
 
 	private:
+		// Points the slot of the given type to the first remaining component of that type
+		void UpdateComponentSlot(ComponentType type);
+		// Re-submits the entity to the renderer and makes the scene resolve
+		void OnComponentsChanged();
+
 		uint32_t m_id			= 0;
 		std::string m_name			= "Entity";
 		bool m_is_active			= true;
@@ -207,6 +213,8 @@ namespace Spartan
 
 		// Components
 		std::vector<std::shared_ptr<IComponent>> m_components;
+		// First component of each type, indexed by type, for constant time lookups
+		std::array<std::shared_ptr<IComponent>, ComponentType_Unknown> m_component_slots;
 		std::shared_ptr<Entity> m_component_empty;
 
 		// Misc
@@ -28,14 +28,18 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Components/Script.h"
 #include "Components/Skybox.h"
 #include "Components/AudioListener.h"
+#include "Components/Renderable.h"
+#include "BoundingVolumeHierarchy.h"
 #include "../Core/Engine.h"
 #include "../Core/Stopwatch.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/ProgressReport.h"
 #include "../IO/FileStream.h"
+#include "../IO/Streaming.h"
 #include "../Profiling/Profiler.h"
 #include "../Rendering/Renderer.h"
 #include "../Input/Input.h"
+#include "../Threading/Threading.h"
 //=====================================
 
 //= NAMESPACES ================
@@ -49,6 +53,7 @@ namespace Spartan
 	{
 		m_isDirty	= true;
 		m_state		= Ticking;
+		m_bvh		= make_unique<BoundingVolumeHierarchy>();
 		
 		// Subscribe to events
 		SUBSCRIBE_TO_EVENT(Event_World_Resolve, [this](Variant) { m_isDirty = true; });
@@ -63,8 +68,9 @@ namespace Spartan
 
 	bool World::Initialize()
 	{
-		m_input		= m_context->GetSubsystem<Input>().get();
-		m_profiler	= m_context->GetSubsystem<Profiler>().get();
+		m_input		= m_context->GetSubsystem<Input>();
+		m_profiler	= m_context->GetSubsystem<Profiler>();
+		m_threading	= m_context->GetSubsystem<Threading>();
 
 		CreateCamera();
 		CreateSkybox();
@@ -116,27 +122,241 @@ namespace Spartan
 			}
 		}
 
+		TransformsUpdate();
+		SpatialIndexUpdate();
+
 		TIME_BLOCK_END(m_profiler);
 
+		// Submit the changes to the Renderer
+		if (m_changes.reset || !m_changes.entities_changed.empty() || !m_changes.entities_removed.empty())
+		{
+			FIRE_EVENT_DATA(Event_World_Submit, static_cast<const WorldChanges*>(&m_changes));
+			m_changes.entities_changed.clear();
+			m_changes.entities_removed.clear();
+			m_changes.reset = false;
+			m_changes_lookup.clear();
+		}
+		m_isDirty = false;
+	}
+
+	void World::TransformsUpdate()
+	{
+		// Flatten the hierarchy by depth, only when it has changed
 		if (m_isDirty)
 		{
-			m_entities_secondary = m_entities_primary;
-			// Submit to the Renderer
-			FIRE_EVENT_DATA(Event_World_Submit, m_entities_secondary);
-			m_isDirty = false;
+			m_transforms.clear();
+			m_transform_levels.clear();
+
+			for (const auto& entity : m_entities_primary)
+			{
+				if (entity->GetTransform_PtrRaw()->IsRoot())
+				{
+					m_transforms.emplace_back(entity->GetTransform_PtrRaw());
+				}
+			}
+
+			uint32_t level_start = 0;
+			while (level_start < static_cast<uint32_t>(m_transforms.size()))
+			{
+				const auto level_end = static_cast<uint32_t>(m_transforms.size());
+				m_transform_levels.emplace_back(level_start);
+				for (auto i = level_start; i < level_end; i++)
+				{
+					for (const auto& child : m_transforms[i]->GetChildren())
+					{
+						m_transforms.emplace_back(child);
+					}
+				}
+				level_start = level_end;
+			}
+			m_transform_levels.emplace_back(static_cast<uint32_t>(m_transforms.size()));
+		}
+
+		// Within a level, transforms only read their parent, which was resolved by the previous level
+		for (uint32_t level = 0; level + 1 < static_cast<uint32_t>(m_transform_levels.size()); level++)
+		{
+			const auto start = m_transform_levels[level];
+			const auto count = m_transform_levels[level + 1] - start;
+			m_threading->ParallelFor(count, 256, [this, start](const uint32_t i)
+			{
+				auto transform = m_transforms[start + i];
+				if (transform->IsDirty())
+				{
+					transform->GetMatrix();
+				}
+			});
+		}
+	}
+
+	void World::SpatialIndexUpdate()
+	{
+		// Pick up added and removed renderables
+		if (m_isDirty)
+		{
+			unordered_map<Entity*, uint32_t> nodes_previous;
+			for (const auto& proxy : m_bvh_proxies)
+			{
+				if (proxy.node != BoundingVolumeHierarchy::node_null)
+				{
+					nodes_previous[proxy.entity] = proxy.node;
+				}
+			}
+
+			vector<_SpatialProxy> proxies;
+			proxies.reserve(m_bvh_proxies.size());
+			for (const auto& entity : m_entities_primary)
+			{
+				auto renderable = entity->GetRenderable_PtrRaw();
+				if (!renderable || entity->HasComponent<Skybox>())
+					continue;
+
+				const auto& box	= renderable->GeometryAabb();
+				auto node		= BoundingVolumeHierarchy::node_null;
+				const auto it	= nodes_previous.find(entity.get());
+				if (it != nodes_previous.end())
+				{
+					node = it->second;
+					m_bvh->Move(node, box);
+					nodes_previous.erase(it);
+				}
+				else
+				{
+					node = m_bvh->Insert(box, entity.get());
+				}
+
+				proxies.push_back({ entity.get(), node, entity->GetTransform_PtrRaw()->GetVersion() });
+			}
+
+			// Whatever is left was removed
+			for (const auto& node : nodes_previous)
+			{
+				m_bvh->Remove(node.second);
+			}
+
+			m_bvh_proxies = move(proxies);
+			m_bvh_proxy_index.clear();
+			for (uint32_t i = 0; i < static_cast<uint32_t>(m_bvh_proxies.size()); i++)
+			{
+				m_bvh_proxy_index[m_bvh_proxies[i].entity] = i;
+			}
+		}
+
+		// Move the leaves whose transform has changed, the tree is only touched when they leave their enlarged box
+		for (auto& proxy : m_bvh_proxies)
+		{
+			if (proxy.node == BoundingVolumeHierarchy::node_null)
+				continue;
+
+			// The renderable might have been removed, its leaf is dropped when the world resolves
+			const auto renderable = proxy.entity->GetRenderable_PtrRaw();
+			if (!renderable)
+				continue;
+
+			const auto version = proxy.entity->GetTransform_PtrRaw()->GetVersion();
+			if (version != proxy.transform_version)
+			{
+				m_bvh->Move(proxy.node, renderable->GeometryAabb());
+				proxy.transform_version = version;
+			}
 		}
 	}
 
+	void World::SpatialIndexRemove(const Entity* entity)
+	{
+		const auto it = m_bvh_proxy_index.find(entity);
+		if (it == m_bvh_proxy_index.end())
+			return;
+
+		// Take the leaf out of the tree right away, so that queries never see an entity which is gone
+		auto& proxy = m_bvh_proxies[it->second];
+		m_bvh->Remove(proxy.node);
+		proxy.node = BoundingVolumeHierarchy::node_null;
+		m_bvh_proxy_index.erase(it);
+	}
+
+	void World::QueryBox(const BoundingBox& box, vector<Entity*>* entities) const
+	{
+		m_bvh->QueryBox(box, [&box, entities](Entity* entity)
+		{
+			const auto renderable = entity->GetRenderable_PtrRaw();
+			if (renderable && box.IsInside(renderable->GeometryAabb()) != Outside)
+			{
+				entities->emplace_back(entity);
+			}
+		});
+	}
+
+	void World::QuerySphere(const Vector3& center, const float radius, vector<Entity*>* entities) const
+	{
+		m_bvh->QuerySphere(center, radius, [&center, radius, entities](Entity* entity)
+		{
+			const auto renderable = entity->GetRenderable_PtrRaw();
+			if (!renderable)
+				return;
+
+			const auto& box		= renderable->GeometryAabb();
+			const auto closest	= Vector3
+			(
+				Helper::Clamp(center.x, box.GetMin().x, box.GetMax().x),
+				Helper::Clamp(center.y, box.GetMin().y, box.GetMax().y),
+				Helper::Clamp(center.z, box.GetMin().z, box.GetMax().z)
+			);
+			if ((closest - center).LengthSquared() <= radius * radius)
+			{
+				entities->emplace_back(entity);
+			}
+		});
+	}
+
+	void World::QueryFrustum(const Frustum& frustum, vector<Entity*>* entities) const
+	{
+		m_bvh->QueryFrustum(frustum, [&frustum, entities](Entity* entity)
+		{
+			const auto renderable = entity->GetRenderable_PtrRaw();
+			if (!renderable)
+				return;
+
+			const auto& box = renderable->GeometryAabb();
+			if (frustum.CheckCube(box.GetCenter(), box.GetExtents()) != Outside)
+			{
+				entities->emplace_back(entity);
+			}
+		});
+	}
+
+	void World::QueryRay(const Ray& ray, vector<Entity*>* entities) const
+	{
+		m_bvh->QueryRay(ray, [&ray, entities](Entity* entity)
+		{
+			const auto renderable = entity->GetRenderable_PtrRaw();
+			if (renderable && ray.HitDistance(renderable->GeometryAabb()) != INFINITY)
+			{
+				entities->emplace_back(entity);
+			}
+		});
+	}
+
 	void World::Unload()
 	{
 		FIRE_EVENT(Event_World_Unload);
 
+		// The renderer might still be using them, so they are released once it has dropped them
+		m_changes.reset = true;
+		m_changes.entities_changed.clear();
+		m_changes_lookup.clear();
+		m_changes.entities_removed.insert(m_changes.entities_removed.end(), make_move_iterator(m_entities_primary.begin()), make_move_iterator(m_entities_primary.end()));
+
 		m_entities_primary.clear();
 		m_entities_primary.shrink_to_fit();
+		m_entity_index_by_id.clear();
+		m_entity_ids_by_name.clear();
+		m_transforms.clear();
+		m_transform_levels.clear();
+		m_bvh->Clear();
+		m_bvh_proxies.clear();
+		m_bvh_proxy_index.clear();
 
 		m_isDirty = true;
-		
-		// Don't clear secondary m_entities_secondary as they might be used by the renderer
 	}
 
 	bool World::SaveToFile(const string& filePathIn)
@@ -218,16 +438,25 @@ namespace Spartan
 		// Unload current entities
 		Unload();
 
-		// Read all the resource file paths
-		auto file = make_unique<FileStream>(file_path, FileStream_Read);
-		if (!file->IsOpen())
-			return false;
+		// Read the world file in the background, while the subsystems load their data
+		auto streaming = m_context->GetSubsystem<Streaming>();
+		vector<std::byte> world_data;
+		TaskCounter world_read;
+		streaming->Read(file_path, Streaming_Critical, [&world_data](StreamingResult& result) { world_data = move(result.data); }, &world_read);
 
 		m_name = FileSystem::GetFileNameNoExtensionFromFilePath(file_path);
 
 		// Notify subsystems that need to load data
 		FIRE_EVENT(Event_World_Load);
 
+		streaming->Wait(world_read);
+		auto file = make_unique<FileStream>(move(world_data));
+		if (!file->IsOpen())
+		{
+			LOGF_ERROR("Failed to read \"%s\"", file_path.c_str());
+			return false;
+		}
+
 		// Load root entity count
 		auto root_entity_count = file->ReadAs<uint32_t>();
 
@@ -260,7 +489,10 @@ namespace Spartan
 	{
 		auto entity = make_shared<Entity>(m_context);
 		entity->Initialize(entity->AddComponent<Transform>().get());
-		return m_entities_primary.emplace_back(entity);
+		m_entities_primary.emplace_back(entity);
+		IndexAdd(static_cast<uint32_t>(m_entities_primary.size() - 1));
+		EntityOnChanged(entity.get());
+		return m_entities_primary.back();
 	}
 
 	shared_ptr<Entity>& World::EntityAdd(const shared_ptr<Entity>& entity)
@@ -268,7 +500,10 @@ namespace Spartan
 		if (!entity)
 			return m_entity_empty;
 
-		return m_entities_primary.emplace_back(entity);
+		m_entities_primary.emplace_back(entity);
+		IndexAdd(static_cast<uint32_t>(m_entities_primary.size() - 1));
+		EntityOnChanged(entity.get());
+		return m_entities_primary.back();
 	}
 
 	bool World::EntityExists(const shared_ptr<Entity>& entity)
@@ -276,7 +511,7 @@ namespace Spartan
 		if (!entity)
 			return false;
 
-		return EntityGetById(entity->GetId()) != nullptr;
+		return EntityGetById(entity->GetId()) == entity;
 	}
 
 	// Removes an entity and all of it's children
@@ -285,26 +520,37 @@ namespace Spartan
 		if (!entity)
 			return;
 
-		// Remove any descendants
-		auto children = entity->GetTransform_PtrRaw()->GetChildren();
-		for (const auto& child : children)
-		{
-			EntityRemove(child->GetEntity_PtrShared());
-		}
-
 		// Keep a reference to it's parent (in case it has one)
 		auto parent = entity->GetTransform_PtrRaw()->GetParent();
 
-		// Remove this entity
-		for (auto it = m_entities_primary.begin(); it < m_entities_primary.end();)
+		// Gather the entity and all of it's descendants
+		vector<Entity*> pending = { entity.get() };
+		vector<shared_ptr<Entity>> removed;
+		while (!pending.empty())
 		{
-			const auto temp = *it;
-			if (temp->GetId() == entity->GetId())
+			auto current = pending.back();
+			pending.pop_back();
+
+			for (const auto& child : current->GetTransform_PtrRaw()->GetChildren())
+			{
+				pending.emplace_back(child->GetEntity_PtrRaw());
+			}
+
+			const auto it = m_entity_index_by_id.find(current->GetId());
+			if (it == m_entity_index_by_id.end() || m_entities_primary[it->second].get() != current)
+				continue;
+
+			// Swap with the last entity and pop
+			const auto index = it->second;
+			IndexRemove(current);
+			SpatialIndexRemove(current);
+			removed.emplace_back(move(m_entities_primary[index]));
+			if (index != m_entities_primary.size() - 1)
 			{
-				it = m_entities_primary.erase(it);
-				break;
+				m_entities_primary[index] = move(m_entities_primary.back());
+				m_entity_index_by_id[m_entities_primary[index]->GetId()] = index;
 			}
-			++it;
+			m_entities_primary.pop_back();
 		}
 
 		// If there was a parent, update it
@@ -313,6 +559,7 @@ namespace Spartan
 			parent->AcquireChildren();
 		}
 
+		m_changes.entities_removed.insert(m_changes.entities_removed.end(), make_move_iterator(removed.begin()), make_move_iterator(removed.end()));
 		m_isDirty = true;
 	}
 
@@ -332,24 +579,96 @@ namespace Spartan
 
 	const shared_ptr<Entity>& World::EntityGetByName(const string& name)
 	{
-		for (const auto& entity : m_entities_primary)
+		const auto it = m_entity_ids_by_name.find(name);
+		if (it == m_entity_ids_by_name.end() || it->second.empty())
+			return m_entity_empty;
+
+		// Several entities can share a name, return the first one in world order
+		auto index = static_cast<uint32_t>(m_entities_primary.size());
+		for (const auto id : it->second)
 		{
-			if (entity->GetName() == name)
-				return entity;
+			const auto it_index = m_entity_index_by_id.find(id);
+			if (it_index != m_entity_index_by_id.end() && it_index->second < index)
+			{
+				index = it_index->second;
+			}
 		}
 
-		return m_entity_empty;
+		return index < m_entities_primary.size() ? m_entities_primary[index] : m_entity_empty;
 	}
 
 	const shared_ptr<Entity>& World::EntityGetById(const uint32_t id)
 	{
-		for (const auto& entity : m_entities_primary)
+		const auto it = m_entity_index_by_id.find(id);
+		if (it == m_entity_index_by_id.end())
+			return m_entity_empty;
+
+		return m_entities_primary[it->second];
+	}
+
+	void World::EntityOnIdChanged(Entity* entity, const uint32_t id_previous)
+	{
+		const auto it = m_entity_index_by_id.find(id_previous);
+		if (it == m_entity_index_by_id.end() || m_entities_primary[it->second].get() != entity)
+			return;
+
+		const auto index = it->second;
+		m_entity_index_by_id.erase(it);
+		m_entity_index_by_id[entity->GetId()] = index;
+
+		auto& ids = m_entity_ids_by_name[entity->GetName()];
+		ids.erase(id_previous);
+		ids.emplace(entity->GetId());
+	}
+
+	void World::EntityOnRenamed(Entity* entity, const string& name_previous)
+	{
+		if (EntityGetById(entity->GetId()).get() != entity)
+			return;
+
+		const auto it = m_entity_ids_by_name.find(name_previous);
+		if (it != m_entity_ids_by_name.end())
 		{
-			if (entity->GetId() == id)
-				return entity;
+			it->second.erase(entity->GetId());
+			if (it->second.empty())
+			{
+				m_entity_ids_by_name.erase(it);
+			}
 		}
+		m_entity_ids_by_name[entity->GetName()].emplace(entity->GetId());
+	}
 
-		return m_entity_empty;
+	void World::EntityOnChanged(Entity* entity)
+	{
+		if (EntityGetById(entity->GetId()).get() != entity)
+			return;
+
+		if (m_changes_lookup.emplace(entity).second)
+		{
+			m_changes.entities_changed.emplace_back(entity->GetPtrShared());
+		}
+	}
+
+	void World::IndexAdd(const uint32_t index)
+	{
+		const auto& entity = m_entities_primary[index];
+		m_entity_index_by_id[entity->GetId()] = index;
+		m_entity_ids_by_name[entity->GetName()].emplace(entity->GetId());
+	}
+
+	void World::IndexRemove(const Entity* entity)
+	{
+		m_entity_index_by_id.erase(entity->GetId());
+
+		const auto it = m_entity_ids_by_name.find(entity->GetName());
+		if (it != m_entity_ids_by_name.end())
+		{
+			it->second.erase(entity->GetId());
+			if (it->second.empty())
+			{
+				m_entity_ids_by_name.erase(it);
+			}
+		}
 	}
 
 	shared_ptr<Entity>& World::CreateSkybox()
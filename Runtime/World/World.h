@@ -25,6 +25,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include "../Core/EngineDefs.h"
 #include "../Core/ISubsystem.h"
 //=============================
@@ -35,6 +37,17 @@ namespace Spartan
 	class Light;
 	class Input;
 	class Profiler;
+	class Threading;
+	class Transform;
+	class Renderable;
+	class BoundingVolumeHierarchy;
+	namespace Math
+	{
+		class BoundingBox;
+		class Frustum;
+		class Ray;
+		class Vector3;
+	}
 
 	enum Scene_State
 	{
@@ -44,6 +57,17 @@ namespace Spartan
 		Loading
 	};
 
+	// What changed since the last Event_World_Submit, the renderer updates its lists from it
+	struct WorldChanges
+	{
+		// Added entities and entities whose components or material changed
+		std::vector<std::shared_ptr<Entity>> entities_changed;
+		// Kept alive until the renderer has dropped them
+		std::vector<std::shared_ptr<Entity>> entities_removed;
+		// Everything that was submitted before is gone
+		bool reset = false;
+	};
+
 	class SPARTAN_CLASS World : public ISubsystem
 	{
 	public:
@@ -72,6 +96,21 @@ namespace Spartan
 		auto EntityGetCount()		{ return static_cast<uint32_t>(m_entities_primary.size()); }
 		//==========================================================================================
 
+		//= SPATIAL QUERIES ==================================================================================================
+		// Entities with a renderable whose world box passes the test (the skybox is not indexed)
+		void QueryBox(const Math::BoundingBox& box, std::vector<Entity*>* entities) const;
+		void QuerySphere(const Math::Vector3& center, float radius, std::vector<Entity*>* entities) const;
+		void QueryFrustum(const Math::Frustum& frustum, std::vector<Entity*>* entities) const;
+		void QueryRay(const Math::Ray& ray, std::vector<Entity*>* entities) const;
+		//====================================================================================================================
+
+		//= Lookup table maintenance (called by Entity) ========================
+		void EntityOnIdChanged(Entity* entity, uint32_t id_previous);
+		void EntityOnRenamed(Entity* entity, const std::string& name_previous);
+		// Components or material changed, the entity is re-submitted to the renderer
+		void EntityOnChanged(Entity* entity);
+		//======================================================================
+
 	private:
 		//= COMMON ENTITY CREATION ========================
 		std::shared_ptr<Entity>& CreateSkybox();
@@ -79,13 +118,47 @@ namespace Spartan
 		std::shared_ptr<Entity>& CreateDirectionalLight();
 		//================================================
 
-		// Double-buffered actors
+		// Resolves dirty world matrices, one hierarchy level at a time, in parallel
+		void TransformsUpdate();
+		// Keeps the bounding volume hierarchy in sync with the renderables and their transforms
+		void SpatialIndexUpdate();
+		// Removes the leaf of an entity right away, instead of waiting for the next update
+		void SpatialIndexRemove(const Entity* entity);
+
+		//= LOOKUP TABLES ===============================
+		void IndexAdd(uint32_t index);
+		void IndexRemove(const Entity* entity);
+		//===============================================
+
 		std::vector<std::shared_ptr<Entity>> m_entities_primary;
-		std::vector<std::shared_ptr<Entity>> m_entities_secondary;
+		// Pending changes for the renderer, and the entities already in them
+		WorldChanges m_changes;
+		std::unordered_set<const Entity*> m_changes_lookup;
+		// Entity id -> index into m_entities_primary
+		std::unordered_map<uint32_t, uint32_t> m_entity_index_by_id;
+		// Entity name -> ids of the entities with that name
+		std::unordered_map<std::string, std::unordered_set<uint32_t>> m_entity_ids_by_name;
+		// All transforms, ordered by depth (parents before children)
+		std::vector<Transform*> m_transforms;
+		// Start of each depth level in m_transforms (plus one past the end)
+		std::vector<uint32_t> m_transform_levels;
+		// Spatial index of the renderables
+		struct _SpatialProxy
+		{
+			Entity* entity;
+			uint32_t node;
+			uint32_t transform_version;
+		};
+		std::unique_ptr<BoundingVolumeHierarchy> m_bvh;
+		// Proxies whose node is node_null belong to removed entities, until the next update drops them
+		std::vector<_SpatialProxy> m_bvh_proxies;
+		// Entity -> index into m_bvh_proxies, only for proxies which are still in the tree
+		std::unordered_map<const Entity*, uint32_t> m_bvh_proxy_index;
 
 		std::shared_ptr<Entity> m_entity_empty;
 		Input* m_input;
 		Profiler* m_profiler;
+		Threading* m_threading;
 		bool m_wasInEditorMode;
 		bool m_isDirty;
 		Scene_State m_state;